@@ -4,69 +4,117 @@
 #include <cstdint>
 #include <cstddef>
 
+class BERWriter;
+struct BERView;
+class OID;
+
+// Compact ASN.1 value used by the codec and the MIB.
+//
+// Scalars are stored in 8 bytes. Strings and OID content octets of up to
+// INLINE_SIZE bytes can be copied in. Longer values reference external
+// storage (a literal, settings, or the packet buffer), which must outlive
+// the object. An OID may also reference an array of components. There is
+// no vtable and no heap; the whole value is 24 bytes.
 class ASN1Object {
 public:
-    enum class Type {
+    enum class Type : uint8_t {
         INTEGER = 0x02,
         OCTET_STRING = 0x04,
         NULL_TYPE = 0x05,
         OBJECT_IDENTIFIER = 0x06,
-        SEQUENCE = 0x30
+        SEQUENCE = 0x30,
+        // SNMP application types (RFC 2578)
+        IP_ADDRESS = 0x40,
+        COUNTER32 = 0x41,
+        GAUGE32 = 0x42,
+        TIMETICKS = 0x43,
+        COUNTER64 = 0x46,
+        // SNMPv2 varbind exceptions (RFC 3416), always empty
+        NO_SUCH_OBJECT = 0x80,
+        NO_SUCH_INSTANCE = 0x81,
+        END_OF_MIB_VIEW = 0x82
     };
-    
-    static constexpr size_t MAX_DATA_SIZE = 256;
+
+    static constexpr size_t INLINE_SIZE = 16;
+
+    static constexpr bool isException(Type type) {
+        return type == Type::NO_SUCH_OBJECT || type == Type::NO_SUCH_INSTANCE ||
+               type == Type::END_OF_MIB_VIEW;
+    }
     static constexpr size_t MAX_OID_LENGTH = 32;
-    static constexpr size_t MAX_STRING_LENGTH = 64;
-    
+
     ASN1Object(Type type = Type::NULL_TYPE);
-    
+
     // Encoding/Decoding
+    // Decoded strings, OIDs and sequences reference the source buffer.
     bool decode(const uint8_t* buffer, uint16_t size, uint16_t& offset);
+    bool decode(const BERView& view);
     uint16_t encode(uint8_t* buffer, uint16_t maxSize) const;
-    
+    bool encode(BERWriter& writer) const;
+    // Exact TLV size either encode() produces, without writing anything;
+    // 0 when the value cannot be encoded
+    uint16_t encodedSize() const;
+
     // Type-specific getters
     int32_t getInteger() const;
+    // Counter32, Gauge32 and TimeTicks; Counter64 via getUnsigned64()
+    uint32_t getUnsigned() const;
+    uint64_t getUnsigned64() const;
+    // Four octets in network order
+    const uint8_t* getIpAddress() const;
+    // Not NUL-terminated; use getStringLength()
     const char* getString() const;
     size_t getStringLength() const;
-    const uint32_t* getOID() const;
-    size_t getOIDLength() const;
-    
+    bool getOID(OID& oid) const;
+
+    // Raw content octets (strings, encoded OIDs, sequences)
+    const uint8_t* getData() const;
+    uint16_t getLength() const { return length_; }
+
     // Type-specific setters
+    // Copying setters fail when the value does not fit inline; the *Ref
+    // setters keep a pointer to the caller's storage instead.
     void setInteger(int32_t value);
-    void setString(const char* value, size_t length);
-    void setOID(const uint32_t* oid, size_t length);
-    
+    void setCounter32(uint32_t value) { setUnsigned(Type::COUNTER32, value); }
+    void setGauge32(uint32_t value) { setUnsigned(Type::GAUGE32, value); }
+    void setTimeTicks(uint32_t value) { setUnsigned(Type::TIMETICKS, value); }
+    void setCounter64(uint64_t value) { setUnsigned(Type::COUNTER64, value); }
+    void setIpAddress(const uint8_t address[4]);
+    bool setString(const char* value, size_t length);
+    void setStringRef(const char* value, size_t length);
+    bool setOID(const uint32_t* oid, size_t length);
+    void setOIDRef(const uint32_t* oid, size_t length);
+    void setOIDRef(const OID& oid);
+    void setSequenceRef(const uint8_t* content, size_t length);
+
     // Type information
     Type getType() const { return type_; }
     void setType(Type type) { type_ = type; }
-    
+
 private:
+    enum class Storage : uint8_t {
+        SCALAR,
+        INLINE,
+        EXTERNAL,
+        COMPONENTS      // OID as a referenced uint32_t array
+    };
+
     Type type_;
-    uint8_t data_[MAX_DATA_SIZE];
-    size_t data_length_;
-    
-    // For OID and String types
+    Storage storage_;
+    uint16_t length_;   // Content octets, or component count
+
     union {
-        struct {
-            uint32_t components[MAX_OID_LENGTH];
-            size_t count;
-        } oid;
-        struct {
-            char text[MAX_STRING_LENGTH];
-            size_t length;
-        } string;
-        int32_t integer;
+        int64_t integer;
+        uint64_t unsignedValue;
+        uint8_t bytes[INLINE_SIZE];
+        const uint8_t* data;
+        const uint32_t* components;
     } value_;
-    
-    // Helper methods
-    bool decodeLength(const uint8_t* buffer, uint16_t size, uint16_t& offset, uint16_t& length) const;
-    uint16_t encodeLength(uint8_t* buffer, uint16_t maxSize, uint16_t length) const;
-    bool decodeInteger(const uint8_t* buffer, uint16_t size, uint16_t& offset);
-    bool decodeString(const uint8_t* buffer, uint16_t size, uint16_t& offset);
-    bool decodeOID(const uint8_t* buffer, uint16_t size, uint16_t& offset);
-    uint16_t encodeInteger(uint8_t* buffer, uint16_t maxSize) const;
-    uint16_t encodeString(uint8_t* buffer, uint16_t maxSize) const;
-    uint16_t encodeOID(uint8_t* buffer, uint16_t maxSize) const;
+
+    void setUnsigned(Type type, uint64_t value);
+    void setBytes(Type type, const uint8_t* data, size_t length, bool copy);
+    size_t contentSize() const;
+    size_t encodeContent(uint8_t* buffer) const;
 };
 
 #endif // ASN1_OBJECT_H
@@ -2,6 +2,8 @@
 #define ASN1_TYPES_H
 
 #include <Arduino.h>
+#include "ASN1Object.h"
+#include "OID.h"
 
 namespace ASN1 {
 
@@ -13,9 +15,16 @@ constexpr uint8_t OBJECT_IDENTIFIER_TAG = 0x06;
 constexpr uint8_t SEQUENCE_TAG = 0x30;
 
 // SNMP Application-specific Tags
+constexpr uint8_t IPADDRESS_TAG = 0x40; // [APPLICATION 0]
 constexpr uint8_t COUNTER_TAG = 0x41;  // [APPLICATION 1]
 constexpr uint8_t GAUGE_TAG = 0x42;    // [APPLICATION 2]
 constexpr uint8_t TIMETICKS_TAG = 0x43; // [APPLICATION 3]
+constexpr uint8_t COUNTER64_TAG = 0x46; // [APPLICATION 6]
+
+// SNMPv2 exception values (RFC 3416), sent with empty content
+constexpr uint8_t NO_SUCH_OBJECT_TAG = 0x80;   // [CONTEXT 0]
+constexpr uint8_t NO_SUCH_INSTANCE_TAG = 0x81; // [CONTEXT 1]
+constexpr uint8_t END_OF_MIB_VIEW_TAG = 0x82;  // [CONTEXT 2]
 
 // ASN.1 Tag Classes
 enum class TagClass : uint8_t {
@@ -49,101 +58,134 @@ constexpr size_t MAX_OID_LENGTH = 32;       // Maximum OID components
 constexpr size_t MAX_STRING_LENGTH = 256;   // Maximum string length
 constexpr size_t MAX_SEQUENCE_LENGTH = 512; // Maximum sequence length
 
-// Forward declarations
-class Encoder;
-class Decoder;
-
-// Base class for all ASN.1 types
-class Type {
+// Typed views over ASN1Object. They add no storage and no vtable; values
+// reference external storage exactly as ASN1Object does.
+class Integer : public ASN1Object {
 public:
-    virtual ~Type() = default;
-    virtual size_t encode(uint8_t* buffer, size_t size) const = 0;
-    virtual bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) = 0;
-    virtual UniversalTag getTag() const = 0;
-    
-protected:
-    static size_t encodeLength(uint8_t* buffer, size_t length);
-    static bool decodeLength(const uint8_t* buffer, size_t& length, size_t& bytesRead);
-    static size_t encodedLengthSize(size_t length);
+    Integer() : ASN1Object(ASN1Object::Type::INTEGER) {}
+    explicit Integer(int32_t val) { setInteger(val); }
+    
+    UniversalTag getTag() const { return UniversalTag::Integer; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
+    
+    int32_t getValue() const { return getInteger(); }
+    void setValue(int32_t val) { setInteger(val); }
 };
 
-// INTEGER type
-class Integer : public Type {
+// OCTET STRING type; the string is referenced, not copied
+class OctetString : public ASN1Object {
 public:
-    Integer() : value(0) {}
-    explicit Integer(int32_t val) : value(val) {}
+    OctetString() : ASN1Object(ASN1Object::Type::OCTET_STRING) {}
+    explicit OctetString(const char* str) { setValue(str); }
     
-    UniversalTag getTag() const override { return UniversalTag::Integer; }
-    size_t encode(uint8_t* buffer, size_t size) const override;
-    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) override;
+    UniversalTag getTag() const { return UniversalTag::OctetString; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
     
-    int32_t getValue() const { return value; }
-    void setValue(int32_t val) { value = val; }
+    // Not NUL-terminated after decode(); use getLength()
+    const char* getValue() const { return getString(); }
+    void setValue(const char* str);
+};
+
+// NULL type
+class Null : public ASN1Object {
+public:
+    Null() : ASN1Object(ASN1Object::Type::NULL_TYPE) {}
     
-private:
-    int32_t value;
+    UniversalTag getTag() const { return UniversalTag::Null; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
 };
 
-// OCTET STRING type
-class OctetString : public Type {
+// OBJECT IDENTIFIER type; components are referenced, not copied
+class ObjectIdentifier : public ASN1Object {
 public:
-    OctetString() : length(0) { data[0] = '\0'; }
-    explicit OctetString(const char* str);
+    ObjectIdentifier() : ASN1Object(ASN1Object::Type::OBJECT_IDENTIFIER) {}
+    ObjectIdentifier(const uint32_t* components, size_t count);
     
-    UniversalTag getTag() const override { return UniversalTag::OctetString; }
-    size_t encode(uint8_t* buffer, size_t size) const override;
-    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) override;
+    UniversalTag getTag() const { return UniversalTag::ObjectID; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
     
-    const char* getValue() const { return data; }
-    void setValue(const char* str);
+    bool getValue(OID& oid) const { return getOID(oid); }
+    bool setComponents(const uint32_t* newComponents, size_t count);
+};
+
+// SEQUENCE type; content octets are referenced, not copied
+class Sequence : public ASN1Object {
+public:
+    Sequence() : ASN1Object(ASN1Object::Type::SEQUENCE) {}
     
-private:
-    char data[MAX_STRING_LENGTH];
-    size_t length;
+    UniversalTag getTag() const { return UniversalTag::Sequence; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
+    
+    void setValue(const uint8_t* content, size_t length) { setSequenceRef(content, length); }
+    void clear() { setSequenceRef(nullptr, 0); }
 };
 
-// NULL type
-class Null : public Type {
+// SNMP application types (RFC 2578): unsigned, never negative on the wire
+class Counter32 : public ASN1Object {
 public:
-    UniversalTag getTag() const override { return UniversalTag::Null; }
-    size_t encode(uint8_t* buffer, size_t size) const override;
-    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) override;
+    Counter32() : Counter32(0) {}
+    explicit Counter32(uint32_t val) { setCounter32(val); }
+    
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
+    
+    uint32_t getValue() const { return getUnsigned(); }
+    void setValue(uint32_t val) { setCounter32(val); }
 };
 
-// OBJECT IDENTIFIER type
-class ObjectIdentifier : public Type {
+class Gauge32 : public ASN1Object {
 public:
-    ObjectIdentifier() : numComponents(0) {}
-    ObjectIdentifier(const uint32_t* components, size_t count);
+    Gauge32() : Gauge32(0) {}
+    explicit Gauge32(uint32_t val) { setGauge32(val); }
     
-    UniversalTag getTag() const override { return UniversalTag::ObjectID; }
-    size_t encode(uint8_t* buffer, size_t size) const override;
-    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) override;
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
     
-    const uint32_t* getComponents() const { return components; }
-    size_t getComponentCount() const { return numComponents; }
-    bool setComponents(const uint32_t* newComponents, size_t count);
+    uint32_t getValue() const { return getUnsigned(); }
+    void setValue(uint32_t val) { setGauge32(val); }
+};
+
+// Hundredths of a second
+class TimeTicks : public ASN1Object {
+public:
+    TimeTicks() : TimeTicks(0) {}
+    explicit TimeTicks(uint32_t val) { setTimeTicks(val); }
     
-private:
-    uint32_t components[MAX_OID_LENGTH];
-    size_t numComponents;
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
+    
+    uint32_t getValue() const { return getUnsigned(); }
+    void setValue(uint32_t val) { setTimeTicks(val); }
 };
 
-// SEQUENCE type
-class Sequence : public Type {
+class Counter64 : public ASN1Object {
 public:
-    Sequence() : length(0) {}
+    Counter64() : Counter64(0) {}
+    explicit Counter64(uint64_t val) { setCounter64(val); }
+    
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
     
-    UniversalTag getTag() const override { return UniversalTag::Sequence; }
-    size_t encode(uint8_t* buffer, size_t size) const override;
-    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead) override;
+    uint64_t getValue() const { return getUnsigned64(); }
+    void setValue(uint64_t val) { setCounter64(val); }
+};
+
+// IPv4 address, four octets in network order
+class IpAddress : public ASN1Object {
+public:
+    IpAddress() : IpAddress(nullptr) {}
+    explicit IpAddress(const uint8_t address[4]) { setIpAddress(address); }
     
-    bool addData(const uint8_t* data, size_t dataLength);
-    void clear() { length = 0; }
+    size_t encode(uint8_t* buffer, size_t size) const;
+    bool decode(const uint8_t* buffer, size_t size, size_t& bytesRead);
     
-private:
-    uint8_t data[MAX_SEQUENCE_LENGTH];
-    size_t length;
+    const uint8_t* getValue() const { return getIpAddress(); }
+    void setValue(const uint8_t address[4]) { setIpAddress(address); }
 };
 
 // Helper functions for BER encoding/decoding
@@ -0,0 +1,111 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+
+// Bump allocator over caller-owned storage, for data that lives exactly
+// as long as one request.
+//
+// allocate() hands out aligned blocks from the front of the storage;
+// nothing is freed on its own, reset() takes every block back at once.
+// The newest block grows in place, so an array appended to one element
+// at a time stays contiguous without wasting space. Constructors and
+// destructors are not run: keep trivially copyable types in an arena.
+//
+// Not synchronized: use each arena from one core only.
+class Arena {
+public:
+    Arena(uint8_t* storage, size_t capacity)
+        : storage_(storage), capacity_(capacity), used_(0), last_(0), peak_(0) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // nullptr when the rest of the storage is too small
+    void* allocate(size_t size, size_t alignment) {
+        size_t start = alignedOffset(used_, alignment);
+        if (start > capacity_ || size > capacity_ - start) {
+            return nullptr;
+        }
+        last_ = start;
+        setUsed(start + size);
+        return storage_ + start;
+    }
+
+    template <typename T>
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Resizes block to newSize, in place when it is the newest block,
+    // otherwise as a copy in a new one (the old stays used until reset).
+    // nullptr when it does not fit; block is left as it was.
+    void* grow(void* block, size_t oldSize, size_t newSize, size_t alignment) {
+        uint8_t* bytes = static_cast<uint8_t*>(block);
+        if (bytes && bytes == storage_ + last_ && last_ + oldSize == used_) {
+            if (newSize > capacity_ - last_) {
+                return nullptr;
+            }
+            setUsed(last_ + newSize);
+            return block;
+        }
+        void* copy = allocate(newSize, alignment);
+        if (copy && bytes) {
+            memcpy(copy, bytes, oldSize < newSize ? oldSize : newSize);
+        }
+        return copy;
+    }
+
+    template <typename T>
+    T* grow(T* block, size_t oldCount, size_t newCount) {
+        return static_cast<T*>(grow(block, sizeof(T) * oldCount, sizeof(T) * newCount, alignof(T)));
+    }
+
+    // Gives the end of block back when it is the newest; otherwise the
+    // whole block stays used until reset
+    void shrink(void* block, size_t oldSize, size_t newSize) {
+        uint8_t* bytes = static_cast<uint8_t*>(block);
+        if (bytes && bytes == storage_ + last_ && last_ + oldSize == used_ && newSize < oldSize) {
+            used_ = last_ + newSize;
+        }
+    }
+
+    template <typename T>
+    void shrink(T* block, size_t oldCount, size_t newCount) {
+        shrink(static_cast<void*>(block), sizeof(T) * oldCount, sizeof(T) * newCount);
+    }
+
+    void reset() {
+        used_ = 0;
+        last_ = 0;
+    }
+
+    size_t used() const { return used_; }
+    size_t capacity() const { return capacity_; }
+    // Most ever used between resets, for sizing the storage
+    size_t peak() const { return peak_; }
+
+private:
+    uint8_t* storage_;
+    size_t capacity_;
+    size_t used_;
+    size_t last_;       // Offset of the newest block
+    size_t peak_;
+
+    size_t alignedOffset(size_t offset, size_t alignment) const {
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage_) + offset;
+        uintptr_t aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        return offset + static_cast<size_t>(aligned - address);
+    }
+
+    void setUsed(size_t used) {
+        used_ = used;
+        if (used_ > peak_) {
+            peak_ = used_;
+        }
+    }
+};
+
+#endif // ARENA_H
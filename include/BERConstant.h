@@ -0,0 +1,103 @@
+#ifndef BER_CONSTANT_H
+#define BER_CONSTANT_H
+
+#include <cstdint>
+#include <cstddef>
+#include "ASN1Types.h"
+#include "BERKernels.h"
+#include "OID.h"
+
+// Called when a constant value is too large. It is deliberately not
+// constexpr, so reaching it while evaluating a constexpr BERConstant is
+// a compile error.
+void invalidBERConstant();
+
+// A complete value TLV (tag, length and content) encoded at compile time,
+// for MIB nodes whose value never changes after boot:
+//     static constexpr BERConstant SYS_DESCR = BERConstant::string("SNMP Power Monitor v1.0");
+// A static constexpr instance is placed in flash. Answering a GET for
+// such a node copies these bytes; no getter runs and nothing is encoded.
+class BERConstant {
+public:
+    static constexpr size_t MAX_SIZE = 128;
+
+    constexpr BERConstant()
+        : bytes_{}
+        , size_(0)
+    {
+    }
+
+    // OCTET STRING from a literal, without the terminator
+    template <size_t N>
+    static constexpr BERConstant string(const char (&text)[N]) {
+        BERConstant value;
+        if (value.writeHeader(ASN1::OCTET_STRING_TAG, N - 1)) {
+            for (size_t i = 0; i + 1 < N; i++) {
+                value.bytes_[value.size_++] = static_cast<uint8_t>(text[i]);
+            }
+        }
+        return value;
+    }
+
+    static constexpr BERConstant oid(const OID& oid) {
+        BERConstant value;
+        if (value.writeHeader(ASN1::OBJECT_IDENTIFIER_TAG, oid.getEncodedLength())) {
+            for (size_t i = 0; i < oid.getEncodedLength(); i++) {
+                value.bytes_[value.size_++] = oid.getEncoded()[i];
+            }
+        }
+        return value;
+    }
+
+    static constexpr BERConstant integer(int32_t integer) {
+        BERConstant value;
+        if (value.writeHeader(ASN1::INTEGER_TAG, BERKernel::integerSize(integer))) {
+            value.size_ += BERKernel::writeInteger(value.bytes_ + value.size_, integer);
+        }
+        return value;
+    }
+
+    // Counter32, Gauge32 or TimeTicks
+    static constexpr BERConstant unsignedValue(uint8_t tag, uint32_t integer) {
+        BERConstant value;
+        if (value.writeHeader(tag, BERKernel::unsignedSize(integer))) {
+            value.size_ += BERKernel::writeUnsigned(value.bytes_ + value.size_, integer);
+        }
+        return value;
+    }
+
+    // SEQUENCE { first, second }, e.g. a varbind whose value never changes
+    static constexpr BERConstant sequence(const BERConstant& first, const BERConstant& second) {
+        BERConstant value;
+        if (first.isValid() && second.isValid() &&
+            value.writeHeader(ASN1::SEQUENCE_TAG, first.size_ + second.size_)) {
+            for (size_t i = 0; i < first.size_; i++) {
+                value.bytes_[value.size_++] = first.bytes_[i];
+            }
+            for (size_t i = 0; i < second.size_; i++) {
+                value.bytes_[value.size_++] = second.bytes_[i];
+            }
+        }
+        return value;
+    }
+
+    constexpr bool isValid() const { return size_ > 0; }
+    constexpr const uint8_t* data() const { return bytes_; }
+    constexpr uint16_t size() const { return size_; }
+
+private:
+    uint8_t bytes_[MAX_SIZE];
+    uint8_t size_;
+
+    constexpr bool writeHeader(uint8_t tag, size_t contentLength) {
+        if (BERKernel::tlvSize(contentLength) > MAX_SIZE) {
+            invalidBERConstant();
+            return false;
+        }
+        bytes_[0] = tag;
+        size_ = 1 + BERKernel::writeLength(bytes_ + 1, contentLength);
+        return true;
+    }
+};
+
+#endif // BER_CONSTANT_H
@@ -0,0 +1,142 @@
+#ifndef BER_KERNELS_H
+#define BER_KERNELS_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Primitive BER kernels shared by every encoder in the tree (ASN1Object,
+// ASN1::Types, BERWriter, OID).
+//
+// Each *Size() function returns the exact number of octets needed. It is
+// computed from count-leading-zeros, with no loop over the value. Each
+// write*() function stores exactly that many octets at out[0..n) in
+// their final order. Nothing is collected into a temp array and then
+// reversed.
+//
+// Everything is constexpr, so OID literals and other constant TLVs go
+// through the same code at compile time. On the RP2040 (Cortex-M0+, no
+// CLZ instruction) __builtin_clz becomes a small libgcc routine that is
+// still branch-free on the value.
+namespace BERKernel {
+
+// Significant bits in a value; zero counts as one bit
+constexpr uint8_t bitWidth(uint32_t value) {
+    return 32 - __builtin_clz(value | 1);
+}
+
+constexpr uint8_t bitWidth(uint64_t value) {
+    return 64 - __builtin_clzll(value | 1);
+}
+
+// INTEGER content octets for a two's complement value: the significant
+// bits of value ^ sign, plus one sign bit
+constexpr uint8_t integerSize(int32_t value) {
+    return bitWidth(static_cast<uint32_t>(value ^ (value >> 31))) / 8 + 1;
+}
+
+constexpr uint8_t integerSize(int64_t value) {
+    return bitWidth(static_cast<uint64_t>(value ^ (value >> 63))) / 8 + 1;
+}
+
+// INTEGER content octets for an unsigned value (Counter32, Gauge32,
+// TimeTicks, Counter64); a leading zero is added when the top bit is set
+constexpr uint8_t unsignedSize(uint32_t value) {
+    return bitWidth(value) / 8 + 1;
+}
+
+constexpr uint8_t unsignedSize(uint64_t value) {
+    return bitWidth(value) / 8 + 1;
+}
+
+// Definite length field: short form below 128, else 0x80|n plus n octets
+constexpr uint8_t lengthSize(uint32_t length) {
+    return (length < 0x80) ? 1 : 1 + (bitWidth(length) + 7) / 8;
+}
+
+// Base-128 sub-identifier octets
+constexpr uint8_t subidentifierSize(uint32_t value) {
+    return (bitWidth(value) + 6) / 7;
+}
+
+// Content octets for a whole OID, including the packed first two arcs
+constexpr size_t oidContentSize(const uint32_t* components, size_t count) {
+    if (count < 2) return 0;
+    size_t size = subidentifierSize(components[0] * 40 + components[1]);
+    for (size_t i = 2; i < count; i++) {
+        size += subidentifierSize(components[i]);
+    }
+    return size;
+}
+
+// Whole TLV with a single tag octet
+constexpr uint32_t tlvSize(uint32_t contentLength) {
+    return 1 + lengthSize(contentLength) + contentLength;
+}
+
+// Low `count` octets of value, most significant first. Octets beyond the
+// width of value come out as zero, which provides the unsigned leading zero.
+constexpr void writeBigEndian(uint8_t* out, uint32_t value, uint8_t count) {
+    for (uint8_t i = count; i-- > 0;) {
+        out[i] = value & 0xFF;
+        value >>= 8;
+    }
+}
+
+constexpr void writeBigEndian(uint8_t* out, uint64_t value, uint8_t count) {
+    for (uint8_t i = count; i-- > 0;) {
+        out[i] = value & 0xFF;
+        value >>= 8;
+    }
+}
+
+constexpr uint8_t writeInteger(uint8_t* out, int32_t value) {
+    uint8_t size = integerSize(value);
+    writeBigEndian(out, static_cast<uint32_t>(value), size);
+    return size;
+}
+
+constexpr uint8_t writeInteger(uint8_t* out, int64_t value) {
+    uint8_t size = integerSize(value);
+    writeBigEndian(out, static_cast<uint64_t>(value), size);
+    return size;
+}
+
+constexpr uint8_t writeUnsigned(uint8_t* out, uint32_t value) {
+    uint8_t size = unsignedSize(value);
+    writeBigEndian(out, value, size);
+    return size;
+}
+
+constexpr uint8_t writeUnsigned(uint8_t* out, uint64_t value) {
+    // Up to nine octets; the ninth (first) is the leading zero
+    uint8_t size = unsignedSize(value);
+    writeBigEndian(out, value, size);
+    return size;
+}
+
+constexpr uint8_t writeLength(uint8_t* out, uint32_t length) {
+    if (length < 0x80) {
+        out[0] = static_cast<uint8_t>(length);
+        return 1;
+    }
+    uint8_t count = (bitWidth(length) + 7) / 8;
+    out[0] = 0x80 | count;
+    writeBigEndian(out + 1, length, count);
+    return count + 1;
+}
+
+constexpr uint8_t writeSubidentifier(uint8_t* out, uint32_t value) {
+    // Last group has the continuation bit clear, all earlier ones set
+    uint8_t size = subidentifierSize(value);
+    uint8_t i = size - 1;
+    out[i] = value & 0x7F;
+    while (i-- > 0) {
+        value >>= 7;
+        out[i] = 0x80 | (value & 0x7F);
+    }
+    return size;
+}
+
+} // namespace BERKernel
+
+#endif // BER_KERNELS_H
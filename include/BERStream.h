@@ -0,0 +1,92 @@
+#ifndef BER_STREAM_H
+#define BER_STREAM_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Resumable, push-style BER parser.
+//
+// Input arrives in chunks of any size (the two halves of a wrapped W5500
+// RX ring, or SPI bursts as they complete). All parser state lives in the
+// object, so an element may be split anywhere, even inside its tag or
+// length octets.
+//
+// Primitive content is delivered zero-copy whenever it is contiguous in
+// memory, including across chunks that directly follow each other. Only
+// content split by a real discontinuity (the ring wrap) is gathered in a
+// small carry buffer. Content longer than CARRY_SIZE is delivered in
+// pieces instead. Input chunks must stay valid until the primitive they
+// start has been delivered.
+class BERStreamParser {
+public:
+    static constexpr uint8_t MAX_DEPTH = 8;
+    static constexpr uint16_t CARRY_SIZE = 64;
+
+    struct Handler {
+        void* context;
+        // A constructed element starts; depth is its nesting level
+        bool (*onConstructed)(void* context, uint8_t tag, uint16_t length, uint8_t depth);
+        // Primitive content. `carried` means data is in the carry buffer
+        // and only valid during the call; `more` marks all but the last
+        // piece of content delivered in pieces.
+        bool (*onPrimitive)(void* context, uint8_t tag, const uint8_t* data, uint16_t length,
+                            uint8_t depth, bool carried, bool more);
+        // A constructed element ends
+        bool (*onEnd)(void* context, uint8_t tag, uint8_t depth);
+    };
+
+    explicit BERStreamParser(const Handler& handler);
+
+    void reset();
+
+    // Consume a chunk; false once the input is malformed or a handler
+    // callback refused it. Bytes after the top-level element are ignored.
+    bool feed(const uint8_t* chunk, uint16_t size);
+
+    // The top-level element has been fully parsed
+    bool isComplete() const { return state_ == State::DONE; }
+    bool hasError() const { return state_ == State::ERROR; }
+
+private:
+    enum class State : uint8_t {
+        TAG,
+        LENGTH,
+        LENGTH_OCTETS,
+        CONTENT,
+        DONE,
+        ERROR
+    };
+
+    enum class ContentMode : uint8_t {
+        DIRECT,     // Contiguous in the input, starting at contentStart_
+        CARRY,      // Gathered in carry_
+        PIECES      // Delivered piece by piece
+    };
+
+    struct Frame {
+        uint8_t tag;
+        uint32_t end;   // Stream position just past the content
+    };
+
+    Handler handler_;
+    State state_;
+    ContentMode mode_;
+    uint8_t tag_;
+    uint8_t lengthOctets_;
+    uint8_t depth_;
+    uint16_t length_;
+    uint16_t contentSeen_;
+    uint32_t position_;
+    const uint8_t* contentStart_;
+    const uint8_t* inputEnd_;
+    Frame frames_[MAX_DEPTH];
+    uint8_t carry_[CARRY_SIZE];
+
+    bool beginElement(const uint8_t* at);
+    bool consumeContent(const uint8_t* data, uint16_t available, uint16_t& used);
+    bool splitContent();
+    bool finishElement();
+    bool fail();
+};
+
+#endif // BER_STREAM_H
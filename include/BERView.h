@@ -0,0 +1,49 @@
+#ifndef BER_VIEW_H
+#define BER_VIEW_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Non-owning view of one BER TLV inside a buffer.
+// A view never copies content; it is only valid while the buffer it
+// points into is alive and unmodified.
+struct BERView {
+    uint8_t tag;
+    const uint8_t* data;    // First content octet
+    uint16_t length;        // Number of content octets
+
+    BERView() : tag(0), data(nullptr), length(0) {}
+
+    bool isValid() const { return data != nullptr; }
+
+    // Content interpretation (reads straight from the buffer)
+    bool getInteger(int32_t& value) const;
+    bool getUnsigned(uint32_t& value) const;
+    bool getUnsigned64(uint64_t& value) const;
+    bool getOID(uint32_t* components, size_t& count, size_t maxCount) const;
+};
+
+// Forward-only reader that splits a buffer into consecutive TLV views.
+class BERReader {
+public:
+    BERReader(const uint8_t* buffer, uint16_t size);
+
+    // Iterate the content of a constructed element (SEQUENCE, PDU)
+    explicit BERReader(const BERView& constructed);
+
+    // Read the next TLV; fails on truncated or malformed input
+    bool read(BERView& element);
+
+    // Read the next TLV and require a specific tag
+    bool read(uint8_t expectedTag, BERView& element);
+
+    bool atEnd() const { return offset_ >= size_; }
+    uint16_t getOffset() const { return offset_; }
+
+private:
+    const uint8_t* buffer_;
+    uint16_t size_;
+    uint16_t offset_;
+};
+
+#endif // BER_VIEW_H
@@ -0,0 +1,55 @@
+#ifndef BER_WRITER_H
+#define BER_WRITER_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Back-to-front BER encoder.
+// Content is written from the end of the buffer toward the front, so the
+// length of a constructed element is known by the time its header is
+// written. Lengths are emitted once in their final (short or long) form;
+// nothing is ever patched or moved.
+//
+// Typical use for SEQUENCE { a, b }:
+//     uint16_t mark = writer.mark();
+//     writer.writeInteger(TAG, b);     // last element first
+//     writer.writeInteger(TAG, a);
+//     writer.endConstructed(SEQUENCE_TAG, mark);
+class BERWriter {
+public:
+    BERWriter(uint8_t* buffer, uint16_t size);
+
+    // Raw prepends
+    bool writeByte(uint8_t byte);
+    bool writeBytes(const uint8_t* data, uint16_t length);
+    bool writeLength(uint16_t length);
+    bool writeHeader(uint8_t tag, uint16_t length);
+
+    // Primitive TLVs
+    bool writeInteger(uint8_t tag, int32_t value);
+    bool writeUnsigned(uint8_t tag, uint32_t value);
+    bool writeUnsigned64(uint8_t tag, uint64_t value);
+    bool writeOctetString(uint8_t tag, const uint8_t* data, uint16_t length);
+    bool writeNull();
+    bool writeOID(const uint32_t* components, size_t count);
+
+    // Constructed TLVs: wrap everything written since mark()
+    uint16_t mark() const { return size(); }
+    bool endConstructed(uint8_t tag, uint16_t mark);
+
+    // Encoded output, valid once all elements have been written
+    const uint8_t* data() const { return buffer_ + position_; }
+    uint8_t* data() { return buffer_ + position_; }
+    uint16_t size() const { return capacity_ - position_; }
+    bool ok() const { return !overflow_; }
+
+private:
+    uint8_t* buffer_;
+    uint16_t capacity_;
+    uint16_t position_;     // Index of the first written byte
+    bool overflow_;
+
+    bool reserve(uint16_t length);
+};
+
+#endif // BER_WRITER_H
@@ -20,7 +20,9 @@ public:
     // Command handlers
     void handleHelp();
     void handleSetCommunity(const char* community);
+    void handleSetWriteCommunity(const char* community);
     void handleSetNetwork(int argc, char* argv[]);
+    void handleSetTrap(int argc, char* argv[]);
     void handleStatus();
     void handleFactoryReset();
 
@@ -0,0 +1,254 @@
+#ifndef FAIR_QUEUE_H
+#define FAIR_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity request queue with priority classes, shared fairly
+// between clients inside each class.
+//
+// Classes are served highest (0) first; a waiting class is still served
+// once MAX_SKIPS pops in a row have passed it over. Within a class each
+// client is a flow, served by deficit round robin: a flow keeps its turn
+// while its deficit is positive, charge() takes the cost of what it was
+// given (e.g. microseconds of processing), and every new round adds
+// `quantum`. Backlogged clients so get equal shares of that cost, not of
+// requests. A flow whose queue empties leaves the round and its deficit
+// is dropped, as in classic DRR.
+//
+// One client holds at most CLIENT_LIMIT slots, so a flood from one source
+// always leaves room to take in another's request.
+//
+// Storage is member arrays, as in StaticPool. Not synchronized: use each
+// queue from one core only.
+template <typename T, uint8_t Classes, uint8_t Capacity>
+class FairQueue {
+    static_assert(Classes > 0 && Capacity > 0 && Capacity < 0xFF, "Queue capacity must be 1..254");
+
+public:
+    static constexpr uint8_t MAX_SKIPS = 4;
+    static constexpr uint8_t CLIENT_LIMIT = Capacity > 1 ? Capacity - 1 : 1;
+    static constexpr int32_t DEFAULT_QUANTUM = 1000;
+    static constexpr int32_t MAX_CHARGE_QUANTA = 8;     // Caps one charge()
+
+    explicit FairQueue(int32_t quantum = DEFAULT_QUANTUM)
+        : quantum_(quantum > 0 ? quantum : 1)
+        , sequence_(0)
+        , turn_(0)
+        , served_(NONE)
+        , rejected_(0)
+    {
+        for (uint8_t i = 0; i < Capacity; i++) {
+            slots_[i].used = false;
+            flows_[i].active = false;
+        }
+        for (uint8_t i = 0; i < Classes; i++) {
+            skipped_[i] = 0;
+        }
+    }
+
+    FairQueue(const FairQueue&) = delete;
+    FairQueue& operator=(const FairQueue&) = delete;
+
+    // False (and counted) when the queue is full, the class does not
+    // exist or the client already holds CLIENT_LIMIT slots
+    bool push(const T& item, uint8_t priority, uint32_t client) {
+        uint8_t slot = NONE;
+        uint8_t held = 0;
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (!slots_[i].used) {
+                slot = slot == NONE ? i : slot;
+            } else if (slots_[i].client == client) {
+                held++;
+            }
+        }
+        uint8_t flow = findFlow(client, priority);
+        if (flow == NONE) {
+            flow = freeFlow();
+        }
+        if (priority >= Classes || slot == NONE || held >= CLIENT_LIMIT || flow == NONE) {
+            rejected_++;
+            return false;
+        }
+
+        if (!flows_[flow].active) {
+            // Joins the end of its class's round with a fresh quantum
+            flows_[flow].active = true;
+            flows_[flow].client = client;
+            flows_[flow].priority = priority;
+            flows_[flow].deficit = quantum_;
+            flows_[flow].turn = ++turn_;
+        }
+        slots_[slot].used = true;
+        slots_[slot].item = item;
+        slots_[slot].client = client;
+        slots_[slot].priority = priority;
+        slots_[slot].sequence = ++sequence_;
+        return true;
+    }
+
+    // False when empty. The item's cost is then given to charge().
+    bool pop(T& item) {
+        uint8_t chosen = chooseClass();
+        if (chosen == Classes) {
+            return false;
+        }
+
+        // The class's next flow that still has deficit
+        uint8_t flow;
+        while (true) {
+            flow = nextFlow(chosen);
+            if (flows_[flow].deficit > 0) {
+                break;
+            }
+            flows_[flow].deficit += quantum_;
+            flows_[flow].turn = ++turn_;
+        }
+
+        // Oldest slot of that flow
+        uint8_t slot = NONE;
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (slots_[i].used && slots_[i].client == flows_[flow].client &&
+                slots_[i].priority == chosen &&
+                (slot == NONE || slots_[i].sequence < slots_[slot].sequence)) {
+                slot = i;
+            }
+        }
+        item = slots_[slot].item;
+        slots_[slot].used = false;
+
+        served_ = flow;
+        if (countFlow(flow) == 0) {
+            flows_[flow].active = false;
+            served_ = NONE;
+        }
+        return true;
+    }
+
+    void charge(int32_t cost) {
+        if (served_ == NONE || cost <= 0) {
+            return;
+        }
+        int32_t limit = quantum_ * MAX_CHARGE_QUANTA;
+        flows_[served_].deficit -= cost < limit ? cost : limit;
+        served_ = NONE;
+    }
+
+    uint8_t size() const {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < Capacity; i++) {
+            count += slots_[i].used ? 1 : 0;
+        }
+        return count;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // push() calls refused
+    uint32_t getRejected() const { return rejected_; }
+
+private:
+    static constexpr uint8_t NONE = 0xFF;
+
+    struct Slot {
+        bool used;
+        uint8_t priority;
+        uint32_t client;
+        uint32_t sequence;      // Arrival order
+        T item;
+    };
+
+    // One client's slots in one class, while it has any
+    struct Flow {
+        bool active;
+        uint8_t priority;
+        uint32_t client;
+        int32_t deficit;
+        uint32_t turn;          // Place in the class's round
+    };
+
+    Slot slots_[Capacity];
+    Flow flows_[Capacity];
+    uint8_t skipped_[Classes];  // Pops since this class was last served
+    int32_t quantum_;
+    uint32_t sequence_;
+    uint32_t turn_;
+    uint8_t served_;            // Flow of the last pop, until charged
+    uint32_t rejected_;
+
+    uint8_t chooseClass() {
+        uint8_t counts[Classes] = {};
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (slots_[i].used) {
+                counts[slots_[i].priority]++;
+            }
+        }
+
+        uint8_t chosen = Classes;
+        for (uint8_t i = 0; i < Classes; i++) {
+            if (counts[i] == 0) {
+                skipped_[i] = 0;
+                continue;
+            }
+            if (chosen == Classes) {
+                chosen = i;
+            } else if (skipped_[i] >= MAX_SKIPS) {
+                chosen = i;         // Waited long enough
+                break;
+            }
+        }
+        if (chosen == Classes) {
+            return chosen;
+        }
+        for (uint8_t i = 0; i < Classes; i++) {
+            if (i != chosen && counts[i] > 0) {
+                skipped_[i]++;
+            }
+        }
+        skipped_[chosen] = 0;
+        return chosen;
+    }
+
+    // Active flow of the class whose turn it is
+    uint8_t nextFlow(uint8_t priority) const {
+        uint8_t next = NONE;
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (flows_[i].active && flows_[i].priority == priority &&
+                (next == NONE || static_cast<int32_t>(flows_[i].turn - flows_[next].turn) < 0)) {
+                next = i;
+            }
+        }
+        return next;
+    }
+
+    uint8_t findFlow(uint32_t client, uint8_t priority) const {
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (flows_[i].active && flows_[i].client == client && flows_[i].priority == priority) {
+                return i;
+            }
+        }
+        return NONE;
+    }
+
+    uint8_t freeFlow() const {
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (!flows_[i].active) {
+                return i;
+            }
+        }
+        return NONE;
+    }
+
+    uint8_t countFlow(uint8_t flow) const {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < Capacity; i++) {
+            if (slots_[i].used && slots_[i].client == flows_[flow].client &&
+                slots_[i].priority == flows_[flow].priority) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+#endif // FAIR_QUEUE_H
@@ -0,0 +1,17 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// FNV-1a, 32 bit. Cheap, byte at a time; used to pre-filter cache keys
+// before a full compare, never as the only check.
+inline uint32_t fnv1a(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+#endif // HASH_H
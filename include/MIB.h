@@ -2,6 +2,8 @@
 #define MIB_H
 
 #include "ASN1Object.h"
+#include "BERConstant.h"
+#include "OID.h"
 #include <cstddef>
 
 class MIB {
@@ -12,7 +14,12 @@ public:
         STRING,
         OID,
         NULL_TYPE,
-        SEQUENCE
+        SEQUENCE,
+        IP_ADDRESS,
+        COUNTER32,
+        GAUGE32,
+        TIMETICKS,
+        COUNTER64
     };
     
     // MIB node access
@@ -25,6 +32,29 @@ public:
     // Function pointer types for getters and setters
     typedef ASN1Object (*GetterFunction)();
     typedef bool (*SetterFunction)(const ASN1Object&);
+    // Value check run for every varbind of a SET before any setter
+    typedef bool (*ValidatorFunction)(const ASN1Object&);
+    
+    // Why a SET varbind is refused (RFC 3416 error-status values)
+    enum class SetError : uint8_t {
+        NONE = 0,
+        WRONG_TYPE = 7,
+        WRONG_ENCODING = 9,
+        WRONG_VALUE = 10,
+        NO_CREATION = 11,
+        COMMIT_FAILED = 14,
+        UNDO_FAILED = 15,
+        AUTHORIZATION_ERROR = 16,
+        NOT_WRITABLE = 17
+    };
+    
+    // Groups the setters of one SET so their store can apply them once
+    // (e.g. a single flash write) or roll every one of them back
+    struct Transaction {
+        void (*begin)();
+        bool (*commit)();
+        void (*abort)();
+    };
     
     // MIB node definition
     struct Node {
@@ -32,44 +62,124 @@ public:
         Access access;
         GetterFunction getter;
         SetterFunction setter;
-        char oid[64];  // Store OID as string
+        ValidatorFunction validator;
+        const BERConstant* constant;           // Pre-encoded value, or nullptr
+        bool isVolatile;                       // Value changes on its own
+        uint8_t oid[OID::MAX_ENCODED_LENGTH];  // BER content octets
+        uint8_t oidLength;
+    };
+    
+    // One name of a batch lookup; findNodes() fills in node
+    struct Lookup {
+        const uint8_t* oid;                    // Encoded OID content
+        size_t length;
+        const Node* node;                      // Match, or nullptr
     };
     
     static constexpr size_t MAX_NODES = 100;
     static constexpr size_t MAX_OID_STRING_LENGTH = 64;
+    static constexpr size_t MAX_LOOKUPS = 16;  // Names per findNodes()
     
     MIB();
     
-    // Node registration
+    // Node registration; a node registered again replaces the old one
+    bool registerNode(const OID& oid, NodeType type, Access access,
+                     GetterFunction getter, SetterFunction setter = nullptr,
+                     ValidatorFunction validator = nullptr);
     bool registerNode(const char* oid, NodeType type, Access access,
-                     GetterFunction getter, SetterFunction setter = nullptr);
+                     GetterFunction getter, SetterFunction setter = nullptr,
+                     ValidatorFunction validator = nullptr);
+    // Read-only node with a constant value. The MIB keeps a pointer, so
+    // value must outlive it (a static constexpr BERConstant).
+    bool registerNode(const OID& oid, NodeType type, const BERConstant& value);
+    // For a registered node whose getter reads a clock or a live counter,
+    // which no markChanged() covers. Registering the node again clears it.
+    bool setVolatile(const OID& oid);
     
     // Node access
+    bool getValue(const OID& oid, ASN1Object& value) const;
+    bool setValue(const OID& oid, const ASN1Object& value);
     bool getValue(const char* oid, ASN1Object& value) const;
     bool setValue(const char* oid, const ASN1Object& value);
     
+    // Lookups straight from encoded OID content octets, e.g. a request's
+    // varbind in the packet buffer. Nothing is decoded or formatted.
+    bool getValue(const uint8_t* oid, size_t length, ASN1Object& value) const;
+    bool setValue(const uint8_t* oid, size_t length, const ASN1Object& value);
+    // Value TLV of a constant node, ready to copy into a response; false
+    // for nodes with a getter
+    bool getEncodedValue(const uint8_t* oid, size_t length,
+                         const uint8_t*& value, uint16_t& size) const;
+    
+    // Batch lookup for the names of one request. They are visited in OID
+    // order (the array keeps request order) in a single merge pass over
+    // the sorted nodes, each search starting where the previous ended.
+    // With next, node is the first node after the name, as getNextOID()
+    // finds. False when count exceeds MAX_LOOKUPS.
+    bool findNodes(Lookup* lookups, size_t count, bool next) const;
+    // Reads of a node found by findNodes()
+    bool getValue(const Node& node, ASN1Object& value) const;
+    bool getEncodedValue(const Node& node, const uint8_t*& value, uint16_t& size) const;
+    
+    // Two-phase SET: testValue() every varbind (access, type, validator)
+    // first, then setValue() them between beginSet() and commitSet().
+    // abortSet() undoes the setters since beginSet(); without a
+    // transaction it returns false, as nothing can be undone.
+    SetError testValue(const uint8_t* oid, size_t length, const ASN1Object& value) const;
+    void setTransaction(const Transaction& transaction) { transaction_ = transaction; }
+    void beginSet();
+    bool commitSet();
+    bool abortSet();
+    
     // OID navigation
+    bool getNextOID(const OID& oid, OID& nextOid) const;
     bool getNextOID(const char* oid, char* nextOid, size_t maxLength) const;
+    // Next node's encoded OID; points into the MIB
+    bool getNextOID(const uint8_t* oid, size_t length,
+                    const uint8_t*& nextOid, size_t& nextLength) const;
     bool isValidOID(const char* oid) const;
+    // SNMPv2c exception for a name getValue() cannot read: noSuchInstance
+    // when it names, or extends, a registered object (a node, or the
+    // parent of a node ending in .0), else noSuchObject
+    ASN1Object::Type getException(const uint8_t* oid, size_t length) const;
     
     // MIB initialization
     void initialize();
     
+    // Changes on every registration and successful setValue(), so cached
+    // responses can tell they are stale. Modules whose getters read state
+    // that changes elsewhere call markChanged().
+    uint32_t getGeneration() const { return generation_; }
+    void markChanged() { generation_ = generation_ + 1; }
+    // Reads of volatile nodes so far; a response built while this changed
+    // holds a value of the moment and is not cached
+    uint32_t getVolatileReads() const { return volatileReads_; }
+    
 private:
     Node nodes_[MAX_NODES];
     size_t node_count_;
+    Transaction transaction_;
+    volatile uint32_t generation_;     // Bumped from interrupt handlers too
+    mutable uint32_t volatileReads_;
     
     // System group initialization
     void initializeSystemGroup();
     
     // Helper methods
-    static int compareOID(const char* oid1, const char* oid2);
+    // Orders encoded OIDs as their sub-identifiers would order
+    static int compareOID(const uint8_t* oid1, size_t length1,
+                          const uint8_t* oid2, size_t length2);
     static bool getParentOID(const char* oid, char* parent, size_t maxLength);
     static bool isChildOID(const char* parent, const char* child);
     
     // Node management
-    const Node* findNode(const char* oid) const;
-    Node* findNode(const char* oid);
+    const Node* findNode(const uint8_t* oid, size_t length) const;
+    Node* findNode(const uint8_t* oid, size_t length);
+    // First node ordered after oid (binary search)
+    size_t upperBound(const uint8_t* oid, size_t length) const;
+    // Same, for a bound known not to lie before `from`: the step from
+    // there doubles until it passes oid, then a binary search
+    size_t upperBound(const uint8_t* oid, size_t length, size_t from) const;
     bool addNode(const Node& node);
     void sortNodes();  // Keep nodes sorted by OID for efficient lookup
 };
@@ -0,0 +1,115 @@
+#ifndef OID_H
+#define OID_H
+
+#include <cstdint>
+#include <cstddef>
+#include "BERKernels.h"
+
+// Called when an OID literal is malformed. It is deliberately not
+// constexpr, so reaching it while evaluating a constexpr OID is a
+// compile error.
+void invalidOIDLiteral();
+
+// Object identifier holding both its components and its BER content
+// octets (no tag or length).
+//
+// Literals are converted at compile time:
+//     static constexpr OID POWER_STATE_OID{"1.3.6.1.4.1.63050.1.1.0"};
+// A malformed literal ("1..3", "3.1", "1.3.x") does not compile. The
+// encoded bytes can be copied straight into a response.
+class OID {
+public:
+    static constexpr size_t MAX_COMPONENTS = 32;
+    static constexpr size_t MAX_ENCODED_LENGTH = 64;
+
+    constexpr OID()
+        : components_{}
+        , count_(0)
+        , encoded_{}
+        , encodedLength_(0)
+    {
+    }
+
+    template <size_t N>
+    constexpr OID(const char (&text)[N])
+        : OID()
+    {
+        if (!parseText(text, N - 1)) {
+            invalidOIDLiteral();
+        }
+    }
+
+    // Runtime construction (CLI input, packets)
+    static bool parse(const char* text, OID& oid);
+    static bool fromComponents(const uint32_t* components, size_t count, OID& oid);
+    static bool fromEncoded(const uint8_t* encoded, size_t length, OID& oid);
+
+    // Dotted text form, for the CLI and logging only
+    bool toString(char* buffer, size_t maxLength) const;
+
+    constexpr bool isValid() const { return count_ >= 2; }
+    constexpr const uint32_t* getComponents() const { return components_; }
+    constexpr size_t getComponentCount() const { return count_; }
+    constexpr const uint8_t* getEncoded() const { return encoded_; }
+    constexpr size_t getEncodedLength() const { return encodedLength_; }
+
+    bool operator==(const OID& other) const;
+    bool operator!=(const OID& other) const { return !(*this == other); }
+
+private:
+    uint32_t components_[MAX_COMPONENTS];
+    uint8_t count_;
+    uint8_t encoded_[MAX_ENCODED_LENGTH];
+    uint8_t encodedLength_;
+
+    constexpr bool parseText(const char* text, size_t length) {
+        if (length == 0) return false;
+
+        uint64_t value = 0;
+        bool digits = false;
+        for (size_t i = 0; i <= length; i++) {
+            char c = (i < length) ? text[i] : '.';
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + static_cast<uint64_t>(c - '0');
+                if (value > 0xFFFFFFFFull) return false;
+                digits = true;
+            } else if (c == '.' && digits) {
+                if (!append(static_cast<uint32_t>(value))) return false;
+                value = 0;
+                digits = false;
+            } else {
+                return false;
+            }
+        }
+
+        return encode();
+    }
+
+    constexpr bool append(uint32_t component) {
+        if (count_ >= MAX_COMPONENTS) return false;
+        components_[count_++] = component;
+        return true;
+    }
+
+    constexpr bool appendSubidentifier(uint32_t value) {
+        if (encodedLength_ + BERKernel::subidentifierSize(value) > MAX_ENCODED_LENGTH) return false;
+        encodedLength_ += BERKernel::writeSubidentifier(encoded_ + encodedLength_, value);
+        return true;
+    }
+
+    constexpr bool encode() {
+        // First two arcs share one sub-identifier
+        if (count_ < 2 || components_[0] > 2) return false;
+        if (components_[0] < 2 && components_[1] >= 40) return false;
+        if (components_[1] > 0xFFFFFFFFu - 80) return false;
+
+        encodedLength_ = 0;
+        if (!appendSubidentifier(components_[0] * 40 + components_[1])) return false;
+        for (size_t i = 2; i < count_; i++) {
+            if (!appendSubidentifier(components_[i])) return false;
+        }
+        return true;
+    }
+};
+
+#endif // OID_H
@@ -3,17 +3,24 @@
 
 #include "MIB.h"
 #include "ASN1Types.h"
+#include "OID.h"
+#include "TrapEmitter.h"
 #include <cstdint>
 
 class PowerMonitor {
 public:
-    explicit PowerMonitor(MIB& mib);
+    PowerMonitor(MIB& mib, TrapEmitter& traps);
     
     void begin();
     bool isPowerPresent() const;
     uint32_t getPowerLossCount() const;
     uint32_t getLastPowerLossTime() const;
     
+    // Power monitoring OIDs
+    static constexpr OID POWER_STATE_OID{"1.3.6.1.4.1.63050.1.1.0"};      // powerState.0
+    static constexpr OID LAST_POWER_LOSS_OID{"1.3.6.1.4.1.63050.1.2.0"};  // lastPowerLoss.0
+    static constexpr OID POWER_LOSS_COUNT_OID{"1.3.6.1.4.1.63050.1.3.0"}; // powerLossCount.0
+    
 private:
     static constexpr uint8_t POWER_PIN = 27;  // GPIO27 for power monitoring
     static constexpr uint32_t DEBOUNCE_TIME = 50;  // 50ms debounce
@@ -22,14 +29,17 @@ private:
     static constexpr uint8_t POWER_STATE_ON = 1;
     static constexpr uint8_t POWER_STATE_OFF = 0;
     
-    // Power monitoring OIDs
-    static constexpr char POWER_STATE_OID[] = "1.3.6.1.4.1.63050.1.1.0";     // powerState.0
-    static constexpr char LAST_POWER_LOSS_OID[] = "1.3.6.1.4.1.63050.1.2.0"; // lastPowerLoss.0
-    static constexpr char POWER_LOSS_COUNT_OID[] = "1.3.6.1.4.1.63050.1.3.0"; // powerLossCount.0
-    
     MIB& mib_;
+    TrapEmitter& traps_;
     unsigned long lastInterruptTime_;
     
+    // Written by the interrupt handler, read by the MIB getters
+    volatile uint8_t powerState_;
+    volatile uint32_t lastPowerLoss_;       // TimeTicks
+    volatile uint32_t powerLossCount_;
+    
+    static PowerMonitor* instance_;         // For the MIB getters
+    
     void handleInterrupt();
     void initializeMIBNodes();
 };
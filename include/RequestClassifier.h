@@ -0,0 +1,48 @@
+#ifndef REQUEST_CLASSIFIER_H
+#define REQUEST_CLASSIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Sorts inbound datagrams into priority classes from their raw bytes,
+// reading only the message header, PDU tag and varbind count.
+//
+// HIGH:   GetRequests of at most PROBE_VARBINDS names (availability
+//         probes) and Responses (acknowledged informs).
+// NORMAL: other GetRequests, SetRequests and a first GetNextRequest.
+// LOW:    GetBulkRequests, GetNextRequests from a client that sent either
+//         within WALK_WINDOW_MS (a walk in progress), and anything that
+//         does not parse.
+class RequestClassifier {
+public:
+    enum class Priority : uint8_t {
+        HIGH,
+        NORMAL,
+        LOW,
+        COUNT
+    };
+
+    static constexpr uint8_t PROBE_VARBINDS = 4;
+    static constexpr uint8_t MAX_WALKERS = 4;           // Clients tracked
+    static constexpr uint32_t WALK_WINDOW_MS = 2000;
+
+    RequestClassifier();
+
+    Priority classify(const uint8_t* packet, uint16_t size, uint32_t remoteIP, uint32_t now);
+
+    void clear();
+
+private:
+    struct Walker {
+        bool valid;
+        uint32_t remoteIP;
+        uint32_t lastSeen;
+    };
+
+    Walker walkers_[MAX_WALKERS];
+
+    // Notes a walk step; true when the client was already walking
+    bool walk(uint32_t remoteIP, uint32_t now);
+};
+
+#endif // REQUEST_CLASSIFIER_H
@@ -0,0 +1,77 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Small LRU cache of encoded responses for repeated identical polls.
+//
+// The key is everything in a GET, GETNEXT or GETBULK request except the
+// request-id: version, community, PDU type, the two error (or bulk)
+// fields and the varbind OIDs, compared in full after a hash match. An
+// entry holds the response PDU body after its request-id; a hit writes
+// that body back with the new request-id and the request's own version
+// and community in front.
+//
+// An entry is used for at most ttlMs, and only while the MIB generation
+// it was stored under is current (see MIB::getGeneration()). Responses
+// that read a volatile node (MIB::setVolatile(), e.g. sysUpTime) are not
+// stored; the agent compares MIB::getVolatileReads() around the response.
+class ResponseCache {
+public:
+    static constexpr uint8_t CAPACITY = 8;
+    static constexpr uint16_t MAX_KEY_SIZE = 96;
+    static constexpr uint16_t MAX_BODY_SIZE = 256;
+    static constexpr uint32_t DEFAULT_TTL_MS = 1000;
+
+    // Request fields the cache needs, parsed once per request
+    struct Key {
+        uint8_t bytes[MAX_KEY_SIZE];
+        uint16_t length;
+        uint16_t prefixLength;      // Version and community TLVs
+        uint32_t hash;
+        int32_t requestID;
+    };
+
+    explicit ResponseCache(uint32_t ttlMs = DEFAULT_TTL_MS);
+
+    // False when the request is not cacheable (type, size, malformed)
+    static bool makeKey(const uint8_t* request, uint16_t size, Key& key);
+
+    // Writes the cached response for key back to front into buffer.
+    // Returns its length, starting at `response`; 0 on a miss.
+    uint16_t lookup(const Key& key, uint32_t generation, uint32_t now,
+                    uint8_t* buffer, uint16_t capacity, const uint8_t*& response);
+
+    // Keeps the body of an encoded response to the request in key
+    bool store(const Key& key, uint32_t generation, uint32_t now,
+               const uint8_t* response, uint16_t size);
+
+    void clear();
+
+    uint32_t getHits() const { return hits_; }
+    uint32_t getMisses() const { return misses_; }
+
+private:
+    struct Entry {
+        bool valid;
+        uint32_t hash;
+        uint32_t generation;
+        uint32_t storedAt;
+        uint32_t lastUsed;          // LRU tick
+        uint16_t keyLength;
+        uint16_t bodyLength;
+        uint8_t key[MAX_KEY_SIZE];
+        uint8_t body[MAX_BODY_SIZE];
+    };
+
+    Entry entries_[CAPACITY];
+    uint32_t ttlMs_;
+    uint32_t tick_;
+    uint32_t hits_;
+    uint32_t misses_;
+
+    Entry* find(const Key& key);
+};
+
+#endif // RESPONSE_CACHE_H
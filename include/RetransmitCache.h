@@ -0,0 +1,78 @@
+#ifndef RETRANSMIT_CACHE_H
+#define RETRANSMIT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// The most recent responses, to answer a manager's retransmission of a
+// request it already sent.
+//
+// A retransmission comes from the same address and port with the same
+// request-id, and is byte for byte the same datagram (checked by hash).
+// It is answered with the stored response bytes: nothing is decoded, no
+// getter runs and a SET is not applied twice. Entries are used within
+// windowMs of being stored.
+//
+// One client (address and port) holds at most MAX_PER_CLIENT entries and
+// then overwrites its own oldest, so a busy manager cannot push everyone
+// else's responses out. Other stores take a free or expired entry, then
+// the oldest.
+//
+// Responses over MAX_RESPONSE_SIZE are not kept, which keeps the cache
+// at about 4 KB. Those are mostly multi-varbind GETNEXT and GETBULK
+// answers; a retransmission of one is answered again from the MIB, which
+// costs time but gives a correct response. A SET response is the size of
+// its request, so only a SET over about 500 bytes can be applied twice,
+// and writing the same values again leaves the same state.
+class RetransmitCache {
+public:
+    static constexpr uint8_t CAPACITY = 8;
+    static constexpr uint8_t MAX_PER_CLIENT = 2;
+    static constexpr uint16_t MAX_RESPONSE_SIZE = 512;  // Larger ones are not kept
+    static constexpr uint32_t DEFAULT_WINDOW_MS = 5000;
+
+    struct Key {
+        uint32_t remoteIP;
+        uint16_t remotePort;
+        int32_t requestID;
+        uint32_t hash;          // Whole request datagram
+    };
+
+    explicit RetransmitCache(uint32_t windowMs = DEFAULT_WINDOW_MS);
+
+    // False when the request-id cannot be read
+    static bool makeKey(const uint8_t* request, uint16_t size,
+                        uint32_t remoteIP, uint16_t remotePort, Key& key);
+
+    // Response stored for an earlier copy of the request, or nullptr.
+    // Points into the cache; valid until the next store().
+    const uint8_t* find(const Key& key, uint32_t now, uint16_t& size);
+
+    void store(const Key& key, uint32_t now, const uint8_t* response, uint16_t size);
+
+    void clear();
+
+    // Requests answered by find()
+    uint32_t getDuplicates() const { return duplicates_; }
+
+private:
+    struct Entry {
+        bool valid;
+        Key key;
+        uint32_t storedAt;
+        uint32_t sequence;      // Store order
+        uint16_t size;
+        uint8_t response[MAX_RESPONSE_SIZE];
+    };
+
+    Entry entries_[CAPACITY];
+    uint32_t sequence_;
+    uint32_t windowMs_;
+    uint32_t duplicates_;
+
+    bool isLive(const Entry& entry, uint32_t now) const;
+    // Entry the next store() for key overwrites
+    Entry& slotFor(const Key& key, uint32_t now);
+};
+
+#endif // RETRANSMIT_CACHE_H
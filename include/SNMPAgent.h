@@ -5,39 +5,291 @@
 #include "SecurityManager.h"
 #include "MIB.h"
 #include "SNMPMessage.h"
+#include "SNMPRewriter.h"
+#include "SNMPBulkResponder.h"
+#include "StaticPool.h"
+#include "FairQueue.h"
+#include "RequestClassifier.h"
+#include "ResponseCache.h"
+#include "RetransmitCache.h"
+#include "TrapEmitter.h"
 #include "ErrorHandler.h"
 
 class SNMPAgent {
 public:
-    static void processMessages(UDPStack& udp, SecurityManager& security, MIB& mib) {
-        uint8_t buffer[1500];
-        uint16_t size;
-        uint32_t remoteIP;
-        uint16_t remotePort;
-        
-        if (udp.receivePacket(buffer, size, remoteIP, remotePort)) {
-            // Check security before processing
-            if (security.checkAccess(remoteIP, "public")) {  // TODO: Get community from settings
-                SNMPMessage message;
-                if (message.decode(buffer, size)) {
-                    // Process SNMP request
-                    SNMPMessage response;
-                    response.createResponse(message, mib);
-                    
-                    // Send response
-                    uint8_t responseBuffer[1500];
-                    uint16_t responseSize = response.encode(responseBuffer, sizeof(responseBuffer));
-                    if (responseSize > 0) {
-                        udp.sendPacket(responseBuffer, responseSize, remoteIP, remotePort);
-                    }
-                } else {
-                    REPORT_ERROR(ErrorHandler::Severity::WARNING,
-                               ErrorHandler::Category::PROTOCOL,
-                               0x4001,
-                               "Failed to decode SNMP message");
+    static constexpr uint16_t RECEIVE_BUFFER_SIZE = 1500;
+    static constexpr uint8_t CONTEXT_POOL_SIZE = 4;    // Also datagrams waiting
+    static constexpr uint8_t MAX_BATCH = 8;     // Datagrams per loop() pass
+    // Request scratch space, for the most varbinds a datagram can name
+    // (SNMPMessage::MAX_REQUEST_VARBINDS): a view each, then a lookup and
+    // a response varbind (GET, GETNEXT), a decoded value and a response
+    // varbind (SET) or a walk cursor (GetBulk), plus the OID and value
+    // bytes copied into the response, at most one datagram's worth. That
+    // is 96 bytes a varbind on the RP2040 (128 on a 64-bit host), 21 KB
+    // in all; one arena serves every context, as one request is processed
+    // at a time.
+    static constexpr size_t GET_VARBIND_SIZE = sizeof(MIB::Lookup) + sizeof(SNMPMessage::VarBind);
+    static constexpr size_t SET_VARBIND_SIZE = sizeof(ASN1Object) + sizeof(SNMPMessage::VarBind);
+    static constexpr size_t ANSWER_VARBIND_SIZE = GET_VARBIND_SIZE > SET_VARBIND_SIZE ?
+                                                  GET_VARBIND_SIZE : SET_VARBIND_SIZE;
+    static constexpr size_t ARENA_VARBIND_SIZE = sizeof(SNMPMessage::VarBindView) +
+        (ANSWER_VARBIND_SIZE > SNMPBulkResponder::ARENA_PER_VARBIND ?
+         ANSWER_VARBIND_SIZE : SNMPBulkResponder::ARENA_PER_VARBIND);
+    static constexpr size_t ARENA_SIZE = SNMPMessage::MAX_REQUEST_VARBINDS * ARENA_VARBIND_SIZE +
+                                         SNMPMessage::MAX_PACKET_SIZE +
+                                         32;    // Alignment between blocks
+    // Processing time each backlogged client is given per round
+    static constexpr int32_t FAIR_QUANTUM_US = 1000;
+
+    // Agent statistics
+    static constexpr OID RETRANSMISSIONS_OID{"1.3.6.1.4.1.63050.3.1.0"};
+    static constexpr OID FAIR_QUEUE_DROPS_OID{"1.3.6.1.4.1.63050.3.2.0"};
+
+    // Everything one request needs; taken from the pool, never the stack
+    struct Context {
+        uint8_t buffer[RECEIVE_BUFFER_SIZE];
+        UDPStack::Datagram datagram;
+        SNMPMessage request{requestArena()};
+        SNMPMessage response{requestArena()};
+        ResponseCache::Key cacheKey;
+
+        // After the response: nothing of this request is kept
+        void reset() {
+            request.clear();
+            response.clear();
+            requestArena().reset();
+        }
+    };
+
+    // Scratch space of the request being processed
+    static Arena& requestArena() {
+        alignas(8) static uint8_t storage[ARENA_SIZE];
+        static Arena arena(storage, sizeof(storage));
+        return arena;
+    }
+
+    using ContextPool = StaticPool<Context, CONTEXT_POOL_SIZE>;
+    using RequestQueue = FairQueue<Context*,
+                                   static_cast<uint8_t>(RequestClassifier::Priority::COUNT),
+                                   CONTEXT_POOL_SIZE>;
+
+    // Statically allocated, so its RAM is counted at link time
+    static ContextPool& contextPool() {
+        static ContextPool pool;
+        return pool;
+    }
+
+    // Received datagrams by class and client; each holds its context
+    // until served
+    static RequestQueue& pending() {
+        static RequestQueue queue(FAIR_QUANTUM_US);
+        return queue;
+    }
+
+    static RequestClassifier& classifier() {
+        static RequestClassifier classifier;
+        return classifier;
+    }
+
+    // Encoded responses to repeated polls
+    static ResponseCache& responseCache() {
+        static ResponseCache cache;
+        return cache;
+    }
+
+    // Recent responses, for requests that managers send again
+    static RetransmitCache& retransmitCache() {
+        static RetransmitCache cache;
+        return cache;
+    }
+
+    static void registerMIBNodes(MIB& mib) {
+        mib.registerNode(RETRANSMISSIONS_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
+            []() {
+                ASN1Object value(ASN1Object::Type::COUNTER32);
+                value.setCounter32(retransmitCache().getDuplicates());
+                return value;
+            });
+        mib.registerNode(FAIR_QUEUE_DROPS_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
+            []() {
+                ASN1Object value(ASN1Object::Type::COUNTER32);
+                value.setCounter32(pending().getRejected());
+                return value;
+            });
+        mib.setVolatile(RETRANSMISSIONS_OID);
+        mib.setVolatile(FAIR_QUEUE_DROPS_OID);
+    }
+
+    // Handles the datagrams already queued, at most MAX_BATCH per call,
+    // and returns how many; the caller only sleeps when this is 0. Every
+    // free context is filled before each pick, so a probe received
+    // behind a walk is served ahead of it, and clients in one class share
+    // processing time evenly. Datagrams left when the batch ends keep
+    // their context until the next call.
+    static uint8_t processMessages(UDPStack& udp, SecurityManager& security, MIB& mib,
+                                   TrapEmitter& traps) {
+        uint8_t handled = 0;
+        Context* context = nullptr;
+        while (handled < MAX_BATCH) {
+            receive(udp, millis());
+            if (!pending().pop(context)) {
+                break;      // Nothing more queued
+            }
+            uint32_t started = micros();
+            processMessage(*context, udp, security, mib, traps);
+            pending().charge(static_cast<int32_t>(micros() - started));
+            context->reset();
+            contextPool().release(context);
+            handled++;
+        }
+        return handled;
+    }
+
+private:
+    // Queued datagrams into the free contexts, filed by class and client.
+    // One over its client's share is dropped and the context filled
+    // again, at most MAX_BATCH times a call, so a flood from one client
+    // cannot keep the others' requests waiting in the W5500.
+    static void receive(UDPStack& udp, uint32_t now) {
+        uint8_t dropped = 0;
+        while (dropped < MAX_BATCH) {
+            Context* contexts[CONTEXT_POOL_SIZE];
+            UDPStack::Datagram datagrams[CONTEXT_POOL_SIZE];
+            uint8_t wanted = 0;
+            while (wanted < CONTEXT_POOL_SIZE && (contexts[wanted] = contextPool().acquire()) != nullptr) {
+                datagrams[wanted].buffer = contexts[wanted]->buffer;
+                datagrams[wanted].capacity = RECEIVE_BUFFER_SIZE;
+                wanted++;
+            }
+            if (wanted == 0) {
+                return;         // All waiting to be served
+            }
+
+            uint8_t received = udp.receiveBatch(datagrams, wanted);
+            uint8_t refused = 0;
+            for (uint8_t i = 0; i < received; i++) {
+                Context* context = contexts[i];
+                const UDPStack::Datagram& datagram = datagrams[i];
+                context->datagram = datagram;
+                RequestClassifier::Priority priority = classifier().classify(
+                    context->buffer, datagram.size, datagram.remoteIP, now);
+                if (!pending().push(context, static_cast<uint8_t>(priority), datagram.remoteIP)) {
+                    contextPool().release(context);
+                    refused++;
                 }
             }
+            for (uint8_t i = received; i < wanted; i++) {
+                contextPool().release(contexts[i]);
+            }
+
+            dropped += refused;
+            if (refused == 0 || received < wanted) {
+                return;
+            }
+        }
+    }
+
+    static void processMessage(Context& context, UDPStack& udp, SecurityManager& security,
+                               MIB& mib, TrapEmitter& traps) {
+        const UDPStack::Datagram& datagram = context.datagram;
+        uint8_t* buffer = context.buffer;
+        uint16_t size = datagram.size;
+        uint32_t remoteIP = datagram.remoteIP;
+        uint16_t remotePort = datagram.remotePort;
+
+        // Check security before processing
+        const char* community = nullptr;
+        size_t communityLength = 0;
+        if (!SNMPMessage::readCommunity(buffer, size, community, communityLength) ||
+            !security.checkAccess(remoteIP, community, communityLength)) {
+            return;
+        }
+
+        // Acknowledgements of our informs; never answered
+        if (traps.handleResponse(buffer, size, remoteIP)) {
+            return;
+        }
+
+        uint32_t now = millis();
+
+        // A retransmission gets the bytes sent the first time
+        RetransmitCache& retransmits = retransmitCache();
+        RetransmitCache::Key retransmitKey;
+        bool tracked = RetransmitCache::makeKey(buffer, size, remoteIP, remotePort, retransmitKey);
+        const uint8_t* response = nullptr;
+        uint16_t responseSize = 0;
+        if (tracked && (response = retransmits.find(retransmitKey, now, responseSize)) != nullptr) {
+            udp.sendPacket(response, responseSize, remoteIP, remotePort);
+            return;
+        }
+
+        // A repeated poll is answered from the cache
+        ResponseCache& cache = responseCache();
+        ResponseCache::Key& key = context.cacheKey;
+        bool cacheable = ResponseCache::makeKey(buffer, size, key);
+        uint32_t generation = mib.getGeneration();
+        if (cacheable) {
+            responseSize = cache.lookup(key, generation, now, buffer, RECEIVE_BUFFER_SIZE, response);
+        }
+
+        // GET/GETNEXT that can be answered in place, then the general path
+        if (responseSize == 0) {
+            uint32_t volatileReads = mib.getVolatileReads();
+            responseSize = SNMPRewriter::rewrite(buffer, size, RECEIVE_BUFFER_SIZE, mib, response);
+            if (responseSize == 0) {
+                responseSize = respond(context, size, mib, security.getWriteCommunity(), response);
+            }
+            // Values of the moment (sysUpTime, live counters) are not replayed
+            if (responseSize > 0 && cacheable && mib.getVolatileReads() == volatileReads) {
+                cache.store(key, generation, now, response, responseSize);
+            }
+        }
+        if (responseSize > 0) {
+            if (tracked) {
+                retransmits.store(retransmitKey, now, response, responseSize);
+            }
+            udp.sendPacket(response, responseSize, remoteIP, remotePort);
+        }
+    }
+
+public:
+    // Response through SNMPMessage; 0 if there is none to send
+    static uint16_t respond(Context& context, uint16_t size, MIB& mib, const char* writeCommunity,
+                            const uint8_t*& response) {
+        uint8_t* buffer = context.buffer;
+        SNMPMessage& message = context.request;
+        if (!message.decode(buffer, size)) {
+            REPORT_ERROR(ErrorHandler::Severity::WARNING,
+                       ErrorHandler::Category::PROTOCOL,
+                       0x4001,
+                       "Failed to decode SNMP message");
+            return 0;
+        }
+
+        // GetBulk walks straight into the buffer
+        if (message.getPDUType() == SNMPMessage::PDUType::GET_BULK_REQUEST &&
+            message.getVersion() == SNMPMessage::VERSION_2C) {
+            return SNMPBulkResponder::respond(message, mib, buffer, RECEIVE_BUFFER_SIZE, response);
+        }
+
+        // Process SNMP request
+        SNMPMessage& responseMessage = context.response;
+        responseMessage.createResponse(message, mib, writeCommunity);
+
+        // The response holds copies of everything it needs, so it is
+        // encoded over the request. The writer is sized to the exact
+        // response length, so the back-to-front encoding ends at the
+        // start of the buffer.
+        uint16_t responseSize = responseMessage.encodedSize();
+        if (responseSize == 0 || responseSize > SNMPMessage::MAX_PACKET_SIZE) {
+            return 0;
+        }
+        BERWriter writer(buffer, responseSize);
+        if (!responseMessage.encode(writer)) {
+            return 0;
         }
+        response = writer.data();
+        return writer.size();
     }
 };
 
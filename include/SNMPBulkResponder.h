@@ -0,0 +1,59 @@
+#ifndef SNMP_BULK_RESPONDER_H
+#define SNMP_BULK_RESPONDER_H
+
+#include "MIB.h"
+#include "SNMPMessage.h"
+#include <cstdint>
+
+// Answers an SNMPv2c GetBulkRequest (RFC 3416, 4.2.3).
+//
+// A bulk response can hold far more varbinds than SNMPMessage stores, so
+// varbinds are encoded front to back straight into the output as the MIB
+// is walked, and the walk stops at the datagram byte budget instead of a
+// varbind count. The message header is written last, in front of them.
+//
+// Past the last MIB node a varbind gets endOfMibView, and the walk ends
+// once every repeater has reached it.
+class SNMPBulkResponder {
+public:
+    // Encodes the response into buffer, which may be the one the request
+    // was decoded from. Returns the response length, starting at
+    // `response`; 0 if nothing could be encoded. A request with more
+    // varbinds than the arena can walk is answered tooBig.
+    static uint16_t respond(const SNMPMessage& request, MIB& mib,
+                            uint8_t* buffer, uint16_t capacity,
+                            const uint8_t*& response);
+
+private:
+    // Walk position of one request varbind
+    struct Cursor {
+        const uint8_t* oid;
+        uint8_t oidLength;
+        bool end;                                   // endOfMibView reached
+        uint8_t copy[OID::MAX_ENCODED_LENGTH];      // Request OID kept for endOfMibView
+    };
+
+public:
+    // Arena bytes the walk takes per request varbind
+    static constexpr size_t ARENA_PER_VARBIND = sizeof(Cursor);
+
+private:
+    struct Output {
+        uint8_t* buffer;
+        uint16_t capacity;
+        uint16_t start;             // Offset of the first varbind
+        uint32_t used;              // Varbind bytes written
+        uint32_t messageFields;     // Version and community TLVs
+        uint32_t pduFields;         // Request-id and error TLVs
+    };
+
+    static bool start(const uint8_t* oid, size_t length, MIB& mib, Cursor& cursor);
+    static void advance(MIB& mib, Cursor& cursor);
+
+    // Appends the varbind at cursor; false when the budget is reached
+    // (status 0) or the value cannot be read (status genErr)
+    static bool append(MIB& mib, const Cursor& cursor, Output& output, uint8_t& status);
+    static uint32_t messageSize(const Output& output, uint32_t varBindBytes);
+};
+
+#endif // SNMP_BULK_RESPONDER_H
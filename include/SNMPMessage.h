@@ -2,7 +2,11 @@
 #define SNMP_MESSAGE_H
 
 #include "ASN1Object.h"
+#include "Arena.h"
+#include "BERView.h"
+#include "BERWriter.h"
 #include "MIB.h"
+#include "OID.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -13,69 +17,174 @@ public:
         GET_NEXT_REQUEST = 0xA1,
         GET_RESPONSE = 0xA2,
         SET_REQUEST = 0xA3,
-        TRAP = 0xA4
+        TRAP = 0xA4,
+        GET_BULK_REQUEST = 0xA5,    // SNMPv2c only
+        INFORM_REQUEST = 0xA6,      // SNMPv2c only
+        SNMPV2_TRAP = 0xA7          // SNMPv2c only
     };
     
+    // Message version field
+    static constexpr uint8_t VERSION_1 = 0;
+    static constexpr uint8_t VERSION_2C = 1;
+    
     static constexpr size_t MAX_COMMUNITY_LENGTH = 32;
+    // Varbinds the in-place SNMPRewriter takes; a message holds as many
+    // as its arena has room for
     static constexpr size_t MAX_VARBINDS = 16;
-    static constexpr size_t MAX_OID_STRING_LENGTH = 64;
-    
-    // Convert between string and numeric OID representations
-    static bool numericToStringOID(const uint32_t* numericOID, size_t length, char* stringOID, size_t maxLength);
-    static bool stringToNumericOID(const char* stringOID, uint32_t* numericOID, size_t* length, size_t maxLength);
+    static_assert(MAX_VARBINDS <= MIB::MAX_LOOKUPS, "A request must fit one MIB::findNodes()");
+    static constexpr uint16_t SPILL_SIZE = 128;
+    // Arena of messages constructed without one
+    static constexpr size_t SHARED_ARENA_SIZE = 8192;
+    // Largest response: 1500-byte Ethernet MTU less IP and UDP headers
+    static constexpr uint16_t MAX_PACKET_SIZE = 1472;
+    // Most varbinds a MAX_PACKET_SIZE request can name: each takes at
+    // least 7 bytes (SEQUENCE, a one-octet OID and a NULL)
+    static constexpr size_t MAX_REQUEST_VARBINDS = MAX_PACKET_SIZE / 7;
     
+    // Response varbind; the OID is a copy of its BER content octets in
+    // the message's arena, written out as is
     struct VarBind {
-        char oid[MAX_OID_STRING_LENGTH];
+        const uint8_t* oid;
+        uint8_t oidLength;
         ASN1Object value;
     };
     
+    // Decoded request varbind, pointing into the receive buffer
+    struct VarBindView {
+        BERView oid;
+        BERView value;
+    };
+    
+    // Varbinds, views and OID copies are kept in an arena, sized to the
+    // message. The agent's contexts share one, reset after every
+    // response. Messages constructed without one share an
+    // arena that is reset once the last of them is destroyed, which
+    // suits short-lived local messages.
     SNMPMessage();
+    explicit SNMPMessage(Arena& arena);
+    ~SNMPMessage();
+    
+    SNMPMessage(const SNMPMessage&) = delete;
+    SNMPMessage& operator=(const SNMPMessage&) = delete;
+    
+    // Back to the freshly constructed state, for reuse from a pool. Arena
+    // blocks are not handed back; resetting the arena does that.
+    void clear();
+    
+    // Per-request scratch space, also for the responders
+    Arena& getArena() const { return *arena_; }
     
     // Encoding/Decoding
+    // decode() copies nothing: community and varbinds are kept as views
+    // into the buffer, which must outlive this message.
     bool decode(const uint8_t* buffer, uint16_t size);
-    uint16_t encode(uint8_t* buffer, uint16_t maxSize);
     
-    // Response creation
-    void createResponse(const SNMPMessage& request, MIB& mib);
+    // Decode a message split in two (e.g. both halves of a wrapped RX
+    // ring). Only elements crossing the split are copied, into spill_.
+    bool decode(const uint8_t* first, uint16_t firstSize,
+                const uint8_t* second, uint16_t secondSize);
+    
+    // encode(writer) builds the message back to front in the writer's
+    // buffer; the result starts at writer.data(). The buffer overload
+    // returns the message moved to the start of the buffer.
+    bool encode(BERWriter& writer) const;
+    uint16_t encode(uint8_t* buffer, uint16_t maxSize) const;
+    
+    // Exact length encode() will produce, computed without writing
+    // anything; 0 when a varbind cannot be encoded
+    uint16_t encodedSize() const;
+    
+    // Community of an undecoded message, as a view into buffer; false
+    // when the message header cannot be read
+    static bool readCommunity(const uint8_t* buffer, uint16_t size,
+                              const char*& community, size_t& length);
+    
+    // Response creation. A SET is applied only when the request carries
+    // writeCommunity; otherwise, and always when it is nullptr or empty,
+    // the SET gets authorizationError (noSuchName for SNMPv1, RFC 3584 4.4).
+    void createResponse(const SNMPMessage& request, MIB& mib,
+                        const char* writeCommunity = nullptr);
     
     // Getters
     uint8_t getVersion() const { return version_; }
-    const char* getCommunity() const { return community_; }
+    // Not NUL-terminated for decoded messages; use getCommunityLength()
+    const char* getCommunity() const;
+    size_t getCommunityLength() const;
     PDUType getPDUType() const { return pduType_; }
     uint32_t getRequestID() const { return requestID_; }
     uint32_t getErrorStatus() const { return errorStatus_; }
     uint32_t getErrorIndex() const { return errorIndex_; }
+    // GetBulkRequest carries these in the error fields (RFC 3416)
+    int32_t getNonRepeaters() const { return static_cast<int32_t>(errorStatus_); }
+    int32_t getMaxRepetitions() const { return static_cast<int32_t>(errorIndex_); }
     const VarBind* getVarBinds() const { return varBinds_; }
     size_t getVarBindCount() const { return varBind_count_; }
+    const VarBindView* getVarBindViews() const { return varBindViews_; }
+    size_t getVarBindViewCount() const { return varBindView_count_; }
+    // Decoded without every varbind: the arena had no room for the rest.
+    // Such a request is answered tooBig.
+    bool isTruncated() const { return truncated_; }
     
     // Setters
     void setVersion(uint8_t version) { version_ = version; }
     void setCommunity(const char* community);
+    void setCommunity(const char* community, size_t length);
     void setPDUType(PDUType type) { pduType_ = type; }
     void setRequestID(uint32_t id) { requestID_ = id; }
     void setErrorStatus(uint32_t status) { errorStatus_ = status; }
     void setErrorIndex(uint32_t index) { errorIndex_ = index; }
-    bool addVarBind(const char* oid, const ASN1Object& value);
+    bool addVarBind(const OID& oid, const ASN1Object& value);
+    bool addVarBind(const uint8_t* oid, size_t oidLength, const ASN1Object& value);
     
 private:
+    friend class SNMPStreamDecoder;
+    friend struct SNMPSchema;
+    
     uint8_t version_;
     char community_[MAX_COMMUNITY_LENGTH];
     PDUType pduType_;
     uint32_t requestID_;
     uint32_t errorStatus_;
     uint32_t errorIndex_;
-    VarBind varBinds_[MAX_VARBINDS];
+    BERView communityView_;
+    Arena* arena_;
+    bool sharedArena_;
+    VarBind* varBinds_;
     size_t varBind_count_;
+    size_t varBind_capacity_;
+    VarBindView* varBindViews_;
+    size_t varBindView_count_;
+    size_t varBindView_capacity_;
+    bool truncated_;
+    // Decoded elements that were split across input chunks
+    uint8_t spill_[SPILL_SIZE];
+    uint16_t spillUsed_;
     
     // Helper methods
-    bool decodePDU(const uint8_t* buffer, uint16_t size, uint16_t& offset);
-    bool decodeVarBinds(const uint8_t* buffer, uint16_t size, uint16_t& offset);
-    uint16_t encodePDU(uint8_t* buffer, uint16_t maxSize);
-    uint16_t encodeVarBinds(uint8_t* buffer, uint16_t maxSize);
+    bool encodeVarBinds(BERWriter& writer) const;
+    // Room in the arena for count entries; false when it is full
+    bool reserveVarBinds(size_t count);
+    bool reserveVarBindViews(size_t count);
+    // Spare view capacity back to the arena, once decoded
+    void trimVarBindViews();
+    
+    // Size helpers shared by encodedSize() and the tooBig checks
+    static uint16_t varBindSize(size_t oidContentLength, const ASN1Object& value);
+    uint32_t sizeWithVarBinds(uint32_t varBindBytes) const;
     
     // Response processing helpers
     void processGetRequest(const SNMPMessage& request, MIB& mib);
     void processGetNextRequest(const SNMPMessage& request, MIB& mib);
+    void processSetRequest(const SNMPMessage& request, MIB& mib, const char* writeCommunity);
+    // Nodes for every request varbind, in the arena; tooBig when the
+    // arena has no room for them, genErr if they cannot be looked up
+    MIB::Lookup* findNodes(const SNMPMessage& request, MIB& mib, bool next);
+    // Error status for a SET, with the request's varbinds echoed
+    // unchanged as RFC 1157 4.1.5 and RFC 3416 4.2.5 require
+    void setSetError(const SNMPMessage& request, MIB::SetError error, size_t index);
+    void echoVarBinds(const SNMPMessage& request);
+    bool addResponseVarBind(const uint8_t* oid, size_t oidLength,
+                            const ASN1Object& value, uint32_t& varBindBytes);
 };
 
 #endif // SNMP_MESSAGE_H
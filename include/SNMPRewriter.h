@@ -0,0 +1,45 @@
+#ifndef SNMP_REWRITER_H
+#define SNMP_REWRITER_H
+
+#include "ASN1Object.h"
+#include "BERView.h"
+#include "MIB.h"
+#include "SNMPMessage.h"
+#include <cstdint>
+
+// Fast path that turns a GetRequest/GetNextRequest into its GetResponse
+// inside the receive buffer.
+//
+// Version, community, request-id and (for GET) the varbind OIDs are moved
+// as raw bytes; only the PDU tag, error fields and values are new. The
+// response is written back to front from the end of the buffer over the
+// request, which is consumed from its end too, so no second buffer and no
+// SNMPMessage are needed.
+//
+// Anything else (other PDU types, lookup failures, tooBig, too little
+// room) returns 0 with the buffer untouched, and the caller takes the
+// general SNMPMessage path.
+class SNMPRewriter {
+public:
+    // Returns the response length, starting at `response`; 0 if the
+    // request needs the general path
+    static uint16_t rewrite(uint8_t* buffer, uint16_t size, uint16_t capacity,
+                            MIB& mib, const uint8_t*& response);
+
+private:
+    struct VarBind {
+        const uint8_t* start;       // Request varbind TLV
+        const uint8_t* oidStart;    // Request OID TLV
+        const uint8_t* valueStart;  // Request value TLV
+        const uint8_t* oid;         // Response OID content (MIB node)
+        size_t oidLength;
+        const uint8_t* encoded;     // Constant value TLV, or nullptr
+        ASN1Object value;
+        uint16_t valueSize;
+    };
+
+    static bool resolve(const BERView& list, bool getNext, MIB& mib,
+                        VarBind* varbinds, size_t& count);
+};
+
+#endif // SNMP_REWRITER_H
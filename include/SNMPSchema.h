@@ -0,0 +1,321 @@
+#ifndef SNMP_SCHEMA_H
+#define SNMP_SCHEMA_H
+
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+#include "BERKernels.h"
+#include "BERStream.h"
+#include "BERView.h"
+#include "BERWriter.h"
+
+// Compile-time description of the SNMP message layout.
+//
+// Every node is a type with only static members. One schema drives the
+// back-to-front encoder, encodedSize() and the streaming decoder, so all
+// PDU types share the same code. Field lists are expanded at compile time
+// by template recursion and fold expressions, so there is no virtual call
+// or function pointer per field.
+//
+// Decoding is event driven (see BERStreamParser). Each event is routed
+// down the schema using the field index recorded for every open level.
+// Fields past the end of a schema are skipped along with their content.
+struct SNMPSchema {
+    enum class EventKind : uint8_t {
+        BEGIN,      // Constructed element starts
+        VALUE,      // Primitive element, content in view
+        END         // Constructed element ends
+    };
+
+    struct Event {
+        EventKind kind;
+        uint8_t tag;
+        uint8_t depth;
+        BERView view;
+    };
+
+    struct Context {
+        SNMPMessage* message;
+        uint8_t index[BERStreamParser::MAX_DEPTH];  // Current field at each level
+        uint8_t open;                               // Open constructed elements
+        uint16_t error;                             // Code to report, 0 if silent
+
+        bool fail(uint16_t code) {
+            error = code;
+            return false;
+        }
+    };
+
+    // Tag rules for constructed nodes
+    template <uint8_t Tag, uint16_t ErrorCode = 0>
+    struct FixedTag {
+        static constexpr uint16_t ERROR_CODE = ErrorCode;
+        static bool accept(Context&, uint8_t tag) { return tag == Tag; }
+        static uint8_t tag(const SNMPMessage&) { return Tag; }
+    };
+
+    // The PDU tag carries the PDU type
+    struct PDUTag {
+        static constexpr uint16_t ERROR_CODE = 0;
+        static bool accept(Context& context, uint8_t tag) {
+            context.message->pduType_ = static_cast<SNMPMessage::PDUType>(tag);
+            return true;
+        }
+        static uint8_t tag(const SNMPMessage& message) {
+            return static_cast<uint8_t>(message.pduType_);
+        }
+    };
+
+    // Behaviour shared by primitive fields
+    template <uint16_t ErrorCode>
+    struct Primitive {
+        static constexpr uint16_t ERROR_CODE = ErrorCode;
+        static bool begin(Context& context, const Event&) { return context.fail(ErrorCode); }
+        static bool end(Context&, uint8_t) { return true; }
+        static bool route(Context&, const Event&, uint8_t) { return true; }
+        static uint16_t pendingError(const Context&, uint8_t) { return ErrorCode; }
+    };
+
+    // INTEGER stored in a message member
+    template <auto Member, uint16_t ErrorCode = 0>
+    struct Integer : Primitive<ErrorCode> {
+        static bool value(Context& context, const Event& event) {
+            int32_t value;
+            if (event.tag != ASN1::INTEGER_TAG || !event.view.getInteger(value)) {
+                return context.fail(ErrorCode);
+            }
+            context.message->*Member = value;
+            return true;
+        }
+        static uint32_t size(const SNMPMessage& message, uint32_t) {
+            return BERKernel::tlvSize(BERKernel::integerSize(static_cast<int32_t>(message.*Member)));
+        }
+        static bool encode(BERWriter& writer, const SNMPMessage& message) {
+            return writer.writeInteger(ASN1::INTEGER_TAG, message.*Member);
+        }
+    };
+
+    // Community string, kept as a view into the input
+    template <uint16_t ErrorCode = 0>
+    struct Community : Primitive<ErrorCode> {
+        static bool value(Context& context, const Event& event) {
+            if (event.tag != ASN1::OCTET_STRING_TAG ||
+                event.view.length >= SNMPMessage::MAX_COMMUNITY_LENGTH) {
+                return context.fail(ErrorCode);
+            }
+            context.message->communityView_ = event.view;
+            return true;
+        }
+        static uint32_t size(const SNMPMessage& message, uint32_t) {
+            return BERKernel::tlvSize(message.getCommunityLength());
+        }
+        static bool encode(BERWriter& writer, const SNMPMessage& message) {
+            return writer.writeOctetString(ASN1::OCTET_STRING_TAG,
+                                           reinterpret_cast<const uint8_t*>(message.getCommunity()),
+                                           message.getCommunityLength());
+        }
+    };
+
+    // Constructed element with a fixed sequence of fields
+    template <typename TagRule, typename... Fields>
+    struct Constructed {
+        static constexpr uint16_t ERROR_CODE = TagRule::ERROR_CODE;
+        static constexpr uint8_t FIELD_COUNT = sizeof...(Fields);
+
+        static bool begin(Context& context, const Event& event) {
+            if (!TagRule::accept(context, event.tag)) {
+                return context.fail(ERROR_CODE);
+            }
+            context.index[event.depth] = 0;
+            return true;
+        }
+
+        static bool value(Context& context, const Event&) {
+            return context.fail(ERROR_CODE);
+        }
+
+        static bool end(Context& context, uint8_t level) {
+            // Every field must be present
+            uint8_t index = context.index[level];
+            return index >= FIELD_COUNT || context.fail(errorAt(index));
+        }
+
+        // Event inside this element, which sits at `level`
+        static bool route(Context& context, const Event& event, uint8_t level) {
+            uint8_t& index = context.index[level];
+            if (event.depth > level + 1) {
+                return visit(index, [&](auto field) {
+                    return decltype(field)::route(context, event, level + 1);
+                });
+            }
+
+            switch (event.kind) {
+                case EventKind::BEGIN:
+                    return visit(index, [&](auto field) {
+                        return decltype(field)::begin(context, event);
+                    });
+                case EventKind::VALUE:
+                    return visit(index++, [&](auto field) {
+                        return decltype(field)::value(context, event);
+                    });
+                case EventKind::END:
+                default:
+                    return visit(index++, [&](auto field) {
+                        return decltype(field)::end(context, level + 1);
+                    });
+            }
+        }
+
+        // Error code for malformed input found while this element is open
+        static uint16_t pendingError(const Context& context, uint8_t level) {
+            uint8_t index = context.index[level];
+            if (context.open == level + 1) {
+                return errorAt(index);
+            }
+            uint16_t code = 0;
+            visit(index, [&](auto field) {
+                code = decltype(field)::pendingError(context, level + 1);
+                return true;
+            });
+            return code;
+        }
+
+        static uint32_t size(const SNMPMessage& message, uint32_t varBindBytes) {
+            return BERKernel::tlvSize((Fields::size(message, varBindBytes) + ... + 0));
+        }
+
+        static bool encode(BERWriter& writer, const SNMPMessage& message) {
+            uint16_t mark = writer.mark();
+            return encodeReversed<Fields...>(writer, message) &&
+                   writer.endConstructed(TagRule::tag(message), mark);
+        }
+
+    private:
+        // Calls visitor with the field at index; fields past the schema
+        // are ignored. Expands to a chain of index comparisons.
+        template <typename Visitor>
+        static bool visit(uint8_t index, Visitor&& visitor) {
+            uint8_t i = 0;
+            bool result = true;
+            (void)((i++ == index ? (result = visitor(Fields()), true) : false) || ...);
+            return result;
+        }
+
+        static uint16_t errorAt(uint8_t index) {
+            uint16_t code = 0;
+            visit(index, [&](auto field) {
+                code = decltype(field)::ERROR_CODE;
+                return true;
+            });
+            return code;
+        }
+
+        // Back to front: the last field is written first
+        template <typename First, typename... Rest>
+        static bool encodeReversed(BERWriter& writer, const SNMPMessage& message) {
+            if constexpr (sizeof...(Rest) > 0) {
+                if (!encodeReversed<Rest...>(writer, message)) {
+                    return false;
+                }
+            }
+            return First::encode(writer, message);
+        }
+    };
+
+    // Fields of one request varbind, stored as views
+    struct VarBindName : Primitive<0> {
+        static bool value(Context& context, const Event& event) {
+            if (event.tag != ASN1::OBJECT_IDENTIFIER_TAG) {
+                return context.fail(0);
+            }
+            SNMPMessage& message = *context.message;
+            message.varBindViews_[message.varBindView_count_].oid = event.view;
+            return true;
+        }
+    };
+
+    struct VarBindValue : Primitive<0> {
+        static bool value(Context& context, const Event& event) {
+            SNMPMessage& message = *context.message;
+            message.varBindViews_[message.varBindView_count_].value = event.view;
+            return true;
+        }
+    };
+
+    // Varbind list. Decodes into request views and encodes the response
+    // varbinds; entries the message's arena has no room for are skipped,
+    // and the message marked truncated.
+    struct VarBindList {
+        using Entry = Constructed<FixedTag<ASN1::SEQUENCE_TAG>, VarBindName, VarBindValue>;
+
+        static constexpr uint16_t ERROR_CODE = 0;
+
+        static bool begin(Context& context, const Event& event) {
+            if (event.tag != ASN1::SEQUENCE_TAG) {
+                return context.fail(0);
+            }
+            context.index[event.depth] = 0;     // Non-zero while skipping an entry
+            return true;
+        }
+
+        static bool value(Context& context, const Event&) { return context.fail(0); }
+        static bool end(Context&, uint8_t) { return true; }
+        static uint16_t pendingError(const Context&, uint8_t) { return 0; }
+
+        static bool route(Context& context, const Event& event, uint8_t level) {
+            SNMPMessage& message = *context.message;
+            uint8_t& skipping = context.index[level];
+
+            if (event.depth > level + 1) {
+                return skipping || Entry::route(context, event, level + 1);
+            }
+
+            switch (event.kind) {
+                case EventKind::BEGIN:
+                    if (!message.reserveVarBindViews(message.varBindView_count_ + 1)) {
+                        message.truncated_ = true;
+                        skipping = 1;
+                        return true;
+                    }
+                    return Entry::begin(context, event);
+                case EventKind::VALUE:
+                    return Entry::value(context, event);
+                case EventKind::END:
+                default:
+                    if (skipping) {
+                        skipping = 0;
+                        return true;
+                    }
+                    if (!Entry::end(context, level + 1)) {
+                        return false;
+                    }
+                    message.varBindView_count_++;
+                    return true;
+            }
+        }
+
+        static uint32_t size(const SNMPMessage&, uint32_t varBindBytes) {
+            return BERKernel::tlvSize(varBindBytes);
+        }
+
+        static bool encode(BERWriter& writer, const SNMPMessage& message) {
+            return message.encodeVarBinds(writer);
+        }
+    };
+
+    // SNMPv1 message (RFC 1157). GetRequest, GetNextRequest, GetResponse
+    // and SetRequest share the PDU layout and differ only in the tag, as
+    // does the SNMPv2c GetBulkRequest, whose error fields hold
+    // non-repeaters and max-repetitions.
+    using PDU = Constructed<PDUTag,
+                            Integer<&SNMPMessage::requestID_>,
+                            Integer<&SNMPMessage::errorStatus_>,
+                            Integer<&SNMPMessage::errorIndex_>,
+                            VarBindList>;
+
+    using Message = Constructed<FixedTag<ASN1::SEQUENCE_TAG, 0x4003>,
+                                Integer<&SNMPMessage::version_, 0x4004>,
+                                Community<0x4005>,
+                                PDU>;
+};
+
+#endif // SNMP_SCHEMA_H
@@ -0,0 +1,48 @@
+#ifndef SNMP_STREAM_DECODER_H
+#define SNMP_STREAM_DECODER_H
+
+#include "BERStream.h"
+#include "SNMPMessage.h"
+#include "SNMPSchema.h"
+
+// Decodes an SNMP message from chunks as they arrive, following the
+// layout in SNMPSchema.
+//
+// Fields keep pointing into the input, as with SNMPMessage::decode().
+// The only exception is an element that a discontinuity (ring wrap)
+// splits; it is copied into the message's spill area.
+//
+//     SNMPStreamDecoder decoder(message);
+//     decoder.begin();
+//     decoder.feed(ringTail, tailLength);
+//     decoder.feed(ringHead, headLength);
+//     if (decoder.finish()) { ... }
+class SNMPStreamDecoder {
+public:
+    explicit SNMPStreamDecoder(SNMPMessage& message);
+
+    void begin();
+    bool feed(const uint8_t* chunk, uint16_t size);
+
+    // True when exactly one complete, well-formed message was decoded
+    bool finish();
+
+private:
+    SNMPMessage& message_;
+    BERStreamParser parser_;
+    SNMPSchema::Context context_;
+    bool errorReported_;
+    const uint8_t* pieceStart_;     // Spill copy of content arriving in pieces
+
+    static bool onConstructed(void* context, uint8_t tag, uint16_t length, uint8_t depth);
+    static bool onPrimitive(void* context, uint8_t tag, const uint8_t* data, uint16_t length,
+                            uint8_t depth, bool carried, bool more);
+    static bool onEnd(void* context, uint8_t tag, uint8_t depth);
+
+    // Route one event through SNMPSchema::Message
+    bool dispatch(const SNMPSchema::Event& event);
+    bool retain(const uint8_t*& data, uint16_t length, bool carried, bool more);
+    bool reject(uint16_t code);
+};
+
+#endif // SNMP_STREAM_DECODER_H
@@ -3,6 +3,7 @@
 
 #include "MIB.h"
 #include "ASN1Types.h"
+#include "OID.h"
 #include <cstdio>
 
 class SecurityManager {
@@ -10,7 +11,12 @@ public:
     explicit SecurityManager(MIB& mib);
     
     // Access control methods
-    bool checkAccess(uint32_t clientIP, const char* community);
+    // Either community is accepted; a SET also needs the write community
+    // (see SNMPMessage::createResponse). Kept by pointer, e.g. into the
+    // settings, so a change applies from the next request.
+    void setCommunities(const char* readCommunity, const char* writeCommunity);
+    const char* getWriteCommunity() const { return writeCommunity_; }
+    bool checkAccess(uint32_t clientIP, const char* community, size_t length);
     void setLogFile(FILE* file);
     
     // Statistics methods
@@ -31,12 +37,14 @@ private:
     };
     
     // MIB OIDs for security statistics
-    static constexpr char ACCESS_ATTEMPTS_OID[] = "1.3.6.1.4.1.63050.2.1.0";
-    static constexpr char INVALID_ACCESSES_OID[] = "1.3.6.1.4.1.63050.2.2.0";
-    static constexpr char RATE_LIMITED_OID[] = "1.3.6.1.4.1.63050.2.3.0";
+    static constexpr OID ACCESS_ATTEMPTS_OID{"1.3.6.1.4.1.63050.2.1.0"};
+    static constexpr OID INVALID_ACCESSES_OID{"1.3.6.1.4.1.63050.2.2.0"};
+    static constexpr OID RATE_LIMITED_OID{"1.3.6.1.4.1.63050.2.3.0"};
     
     MIB& mib_;
     FILE* logFile_ = nullptr;
+    const char* readCommunity_ = "public";
+    const char* writeCommunity_ = nullptr;     // Read-only while null or empty
     
     // Client tracking arrays
     uint32_t clientIPs_[MAX_CLIENTS] = {0};
@@ -44,8 +52,8 @@ private:
     
     // Helper methods
     void logAccess(uint32_t clientIP, bool allowed, const char* reason);
-    void incrementCounter(const char* oid);
-    uint32_t getCounterValue(const char* oid) const;
+    void incrementCounter(const OID& oid);
+    uint32_t getCounterValue(const OID& oid) const;
     size_t findOrCreateClient(uint32_t clientIP);
     
     // Initialize MIB nodes
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <hardware/flash.h>
+#include <cstddef>
 
 // Flash storage constants
 constexpr uint32_t SETTINGS_FLASH_OFFSET = PICO_FLASH_SIZE_BYTES - (1024 * 1024); // 1MB from end of flash
@@ -29,10 +30,25 @@ struct DeviceSettings {
     uint32_t uptime;                     // 4 bytes
     uint32_t lastPowerLoss;              // 4 bytes
     
+    // Taken from the 64 reserved bytes, which older blocks left zero
+    char writeCommunity[32];             // 32 bytes; empty refuses every SET
+    uint8_t trapHost[4];                 // 4 bytes; 0.0.0.0 sends no notifications
+    bool trapInform;                     // 1 byte
+    
     // Reserved space for future expansion
-    uint8_t reserved[64];                // 64 bytes
+    uint8_t reserved[27];                // 27 bytes
+    
+    // MIB-II system group: 192 bytes, more than was reserved, so appended;
+    // blocks saved before it are shorter and load with the defaults
+    char sysContact[64];                 // 64 bytes
+    char sysName[64];                    // 64 bytes
+    char sysLocation[64];                // 64 bytes
 };
 
+// Fields before sysContact keep their offsets in blocks saved by older firmware
+static_assert(offsetof(DeviceSettings, sysContact) - offsetof(DeviceSettings, writeCommunity) == 64,
+              "Fields carved from the reserved space must total 64 bytes");
+
 // Block header structure
 struct BlockHeader {
     uint32_t magic;
@@ -46,6 +62,8 @@ struct BlockFooter {
     uint32_t marker;
 };
 
+class MIB;
+
 class SettingsManager {
 public:
     SettingsManager();
@@ -66,8 +84,24 @@ public:
     bool setSubnetMask(const uint8_t mask[4]);
     bool setGateway(const uint8_t gw[4]);
     bool setCommunityString(const char* community);
+    bool setWriteCommunity(const char* community);
     bool setSNMPPort(uint16_t port);
     bool setRateLimit(uint32_t limit);
+    bool setSysContact(const char* contact, size_t length);
+    bool setSysName(const char* name, size_t length);
+    bool setSysLocation(const char* location, size_t length);
+    bool setTrapDestination(const uint8_t host[4], bool inform);
+    
+    // Batched updates: setters between beginBatch() and commitBatch()
+    // change RAM only, and commitBatch() saves once if anything changed.
+    // abortBatch() restores the settings as they were at beginBatch().
+    void beginBatch();
+    bool commitBatch();
+    void abortBatch();
+    
+    // Writable, persistent sysContact/sysName/sysLocation; a SET PDU
+    // becomes one batch, so one flash write
+    void registerMIBNodes(MIB& mib);
     
     // Statistics updates
     void incrementPowerLossCount();
@@ -78,7 +112,14 @@ private:
     DeviceSettings currentSettings;
     uint32_t activeBlock;
     
+    // Open batch state
+    bool batchOpen;
+    bool batchDirty;
+    DeviceSettings batchSnapshot;
+    
     // Internal helper functions
+    bool persist();     // Save now, or at commitBatch() if a batch is open
+    bool setString(char* field, size_t fieldSize, const char* value, size_t length);
     bool findLatestBlock();
     bool writeBlock(const DeviceSettings& settings, uint32_t blockIndex);
     bool readBlock(DeviceSettings& settings, uint32_t blockIndex);
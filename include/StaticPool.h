@@ -0,0 +1,71 @@
+#ifndef STATIC_POOL_H
+#define STATIC_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity pool of T with explicit acquire/release.
+//
+// Storage is a member array, so a pool with static storage duration sits
+// in .bss and its RAM is known at link time. acquire() and release() are
+// O(1) through a free list of slot indices. Slots are constructed once
+// and handed out as they were left; callers reset what they use.
+//
+// Not synchronized: use each pool from one core only.
+template <typename T, uint8_t Capacity>
+class StaticPool {
+    static_assert(Capacity > 0 && Capacity < 0xFF, "Pool capacity must be 1..254");
+
+public:
+    StaticPool() : free_(0), available_(Capacity) {
+        for (uint8_t i = 0; i < Capacity; i++) {
+            next_[i] = i + 1;
+            inUse_[i] = false;
+        }
+    }
+
+    StaticPool(const StaticPool&) = delete;
+    StaticPool& operator=(const StaticPool&) = delete;
+
+    // nullptr when every slot is taken
+    T* acquire() {
+        if (free_ == NONE) {
+            return nullptr;
+        }
+        uint8_t slot = free_;
+        free_ = next_[slot];
+        inUse_[slot] = true;
+        available_--;
+        return &items_[slot];
+    }
+
+    // False for pointers that are not an acquired slot of this pool
+    bool release(T* item) {
+        if (!item || item < items_ || item >= items_ + Capacity) {
+            return false;
+        }
+        uint8_t slot = static_cast<uint8_t>(item - items_);
+        if (!inUse_[slot]) {
+            return false;
+        }
+        inUse_[slot] = false;
+        next_[slot] = free_;
+        free_ = slot;
+        available_++;
+        return true;
+    }
+
+    uint8_t available() const { return available_; }
+    static constexpr uint8_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint8_t NONE = Capacity;   // End of the free list
+
+    T items_[Capacity];
+    uint8_t next_[Capacity];
+    bool inUse_[Capacity];
+    uint8_t free_;
+    uint8_t available_;
+};
+
+#endif // STATIC_POOL_H
@@ -0,0 +1,101 @@
+#ifndef TRAP_EMITTER_H
+#define TRAP_EMITTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// SNMPv2c notifications (SNMPv2-Trap or InformRequest) for device events.
+//
+// raise() only records the event and its values in a small ring, so it is
+// safe from an interrupt handler or the other core (one producer). The
+// main loop calls process(), which encodes each event once from its
+// template and sends it. The templates hold every constant part of the
+// notification pre-encoded in flash (see BERConstant); only sysUpTime,
+// the event's values and the request-id are written per event.
+//
+// An InformRequest stays queued until the receiver's Response arrives
+// (handleResponse()), and is resent after INFORM_TIMEOUT_MS, doubling
+// each time, up to INFORM_RETRIES times. Nothing here ever waits.
+class TrapEmitter {
+public:
+    enum class Event : uint8_t {
+        POWER_LOST,             // Values: powerState, powerLossCount
+        POWER_RESTORED,         // Values: powerState
+        COUNT
+    };
+
+    static constexpr uint8_t MAX_VALUES = 2;
+    static constexpr uint8_t EVENT_RING_SIZE = 8;
+    static constexpr uint8_t QUEUE_SIZE = 4;
+    static constexpr uint16_t MAX_PDU_SIZE = 192;
+    static constexpr uint16_t TRAP_PORT = 162;
+    static constexpr uint32_t INFORM_TIMEOUT_MS = 1000;
+    static constexpr uint8_t INFORM_RETRIES = 3;
+
+    // Sends one datagram; false if it could not be handed to the network
+    typedef bool (*SendFunction)(const uint8_t* data, uint16_t size,
+                                 uint32_t remoteIP, uint16_t remotePort);
+
+    TrapEmitter();
+
+    // No notifications are sent until a destination is set; remoteIP 0
+    // turns them off again
+    bool setDestination(uint32_t remoteIP, uint16_t remotePort,
+                        const char* community, bool inform);
+
+    // Records an event; timestamp in TimeTicks. False if the ring is full.
+    bool raise(Event event, uint32_t timestamp, const uint32_t* values);
+
+    // From the main loop: encodes raised events, sends what is due
+    void process(uint32_t now, SendFunction send);
+
+    // True if packet is a Response PDU, which is then consumed here; a
+    // matching one acknowledges an outstanding InformRequest
+    bool handleResponse(const uint8_t* packet, uint16_t size, uint32_t remoteIP);
+
+    uint8_t getPending() const;
+    uint32_t getSent() const { return sent_; }
+    uint32_t getAcknowledged() const { return acknowledged_; }
+    uint32_t getFailed() const { return failed_; }      // Informs never acknowledged
+    uint32_t getDropped() const { return ringDropped_ + queueDropped_; }
+
+private:
+    struct RaisedEvent {
+        Event event;
+        uint32_t timestamp;
+        uint32_t values[MAX_VALUES];
+    };
+
+    struct Outbound {
+        bool used;
+        int32_t requestID;
+        uint8_t attempts;
+        uint32_t nextAttempt;
+        uint16_t size;
+        uint8_t bytes[MAX_PDU_SIZE];
+    };
+
+    // Written by raise() only
+    RaisedEvent events_[EVENT_RING_SIZE];
+    volatile uint8_t eventHead_;
+    // Written by process() only
+    volatile uint8_t eventTail_;
+
+    Outbound queue_[QUEUE_SIZE];
+    uint32_t remoteIP_;
+    uint16_t remotePort_;
+    bool inform_;
+    uint8_t header_[40];        // Version and community TLVs
+    uint8_t headerSize_;
+    int32_t nextRequestID_;
+
+    uint32_t sent_;
+    uint32_t acknowledged_;
+    uint32_t failed_;
+    volatile uint32_t ringDropped_;     // Written by raise() only
+    uint32_t queueDropped_;
+
+    bool enqueue(const RaisedEvent& raised, uint32_t now);
+};
+
+#endif // TRAP_EMITTER_H
@@ -14,7 +14,22 @@ public:
     void renewDHCP();
     bool isConnected() const;
     
+    // One datagram of a batch; the caller provides buffer and capacity
+    struct Datagram {
+        uint8_t* buffer;
+        uint16_t capacity;
+        uint16_t size;
+        uint32_t remoteIP;
+        uint16_t remotePort;
+    };
+    
     // UDP packet handling
+    // Never waits: fills datagrams[0..n) with what the W5500 has already
+    // queued, up to count, and returns n (0 when idle). Datagrams larger
+    // than their buffer, or that cannot be read whole, are read out and
+    // dropped; at most count of them per call, so a flood cannot keep it
+    // looping.
+    uint8_t receiveBatch(Datagram* datagrams, uint8_t count);
     bool receivePacket(uint8_t* buffer, uint16_t& size, uint32_t& remoteIP, uint16_t& remotePort);
     bool sendPacket(const uint8_t* buffer, uint16_t size, uint32_t remoteIP, uint16_t remotePort);
     
@@ -27,6 +42,7 @@ private:
     bool dhcpEnabled_;
     uint32_t lastDHCPRenewal_;
     static constexpr uint32_t DHCP_RENEWAL_INTERVAL = 300000;  // 5 minutes
+    static constexpr int DISCARD_CHUNK = 64;    // Stack bytes to drop a datagram
     
     // DHCP helper methods
     bool sendDHCPDiscover();
@@ -35,6 +51,8 @@ private:
     bool receiveDHCPAck();
     
     // UDP helper methods
+    // Reads the rest of the open datagram, up to size bytes, into nothing
+    void discard(int size);
     bool waitForData(uint8_t socket, uint32_t timeout);
     uint16_t getAvailableData(uint8_t socket);
 };
@@ -19,6 +19,7 @@
 class W5500 {
 public:
     W5500(uint8_t cs_pin, uint8_t rst_pin, uint8_t int_pin);
+    virtual ~W5500() = default;
     bool begin();
     void reset();
     bool isLinked();
@@ -38,8 +39,20 @@ public:
     bool beginPacket(const uint8_t* ip, uint16_t port);
     bool endPacket();
     size_t write(const uint8_t* buffer, size_t size);
-    int parsePacket();
-    int read(uint8_t* buffer, size_t size);
+    // Opens the next queued datagram and returns its size. The caller
+    // reads it all (read() until done) before the next parsePacket(),
+    // which does not skip an unread rest. Virtual so tests can stand in
+    // for the receive queue.
+    virtual int parsePacket();
+    // May return fewer bytes than asked for
+    virtual int read(uint8_t* buffer, size_t size);
+    // Sender of the datagram opened by the last parsePacket()
+    uint32_t remoteIP() const { return _remote_ip; }
+    uint16_t remotePort() const { return _remote_port; }
+    
+protected:
+    uint32_t _remote_ip;
+    uint16_t _remote_port;
     
 private:
     uint8_t _cs_pin;
@@ -1,32 +1,79 @@
 #include "ASN1Object.h"
+#include "BERKernels.h"
+#include "BERView.h"
+#include "BERWriter.h"
+#include "OID.h"
 #include <string.h>
 
-ASN1Object::ASN1Object(Type type) : type_(type), data_length_(0) {
+static_assert(sizeof(ASN1Object) <= 24, "ASN1Object must stay compact");
+
+// First arc 0..2, second arc below 40 unless the first is 2
+static bool validArcs(const uint32_t* components, size_t count) {
+    return components && count >= 2 && count <= ASN1Object::MAX_OID_LENGTH &&
+           components[0] <= 2 && (components[0] == 2 || components[1] < 40);
+}
+
+ASN1Object::ASN1Object(Type type) : type_(type), storage_(Storage::SCALAR), length_(0) {
     memset(&value_, 0, sizeof(value_));
 }
 
 bool ASN1Object::decode(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    if (offset >= size) return false;
-    
-    // Read type
-    type_ = static_cast<Type>(buffer[offset++]);
-    
-    // Read length
-    uint16_t length;
-    if (!decodeLength(buffer, size, offset, length)) return false;
-    
+    if (!buffer || offset >= size) return false;
+
+    BERReader reader(buffer + offset, size - offset);
+    BERView view;
+    if (!reader.read(view) || !decode(view)) return false;
+
+    offset += reader.getOffset();
+    return true;
+}
+
+bool ASN1Object::decode(const BERView& view) {
+    if (!view.isValid()) return false;
+
     // Read value based on type
-    switch (type_) {
-        case Type::INTEGER:
-            return decodeInteger(buffer, size, offset);
+    switch (static_cast<Type>(view.tag)) {
+        case Type::INTEGER: {
+            int32_t value;
+            if (!view.getInteger(value)) return false;
+            setInteger(value);
+            return true;
+        }
         case Type::OCTET_STRING:
-            return decodeString(buffer, size, offset);
+            setStringRef(reinterpret_cast<const char*>(view.data), view.length);
+            return true;
         case Type::OBJECT_IDENTIFIER:
-            return decodeOID(buffer, size, offset);
+            // Last octet must end a sub-identifier
+            if (view.length == 0 || (view.data[view.length - 1] & 0x80)) return false;
+            setBytes(Type::OBJECT_IDENTIFIER, view.data, view.length, false);
+            return true;
         case Type::NULL_TYPE:
+        case Type::NO_SUCH_OBJECT:
+        case Type::NO_SUCH_INSTANCE:
+        case Type::END_OF_MIB_VIEW:
+            if (view.length != 0) return false;
+            *this = ASN1Object(static_cast<Type>(view.tag));
             return true;
         case Type::SEQUENCE:
-            offset += length;
+            setSequenceRef(view.data, view.length);
+            return true;
+        case Type::COUNTER32:
+        case Type::GAUGE32:
+        case Type::TIMETICKS: {
+            uint32_t value;
+            if (!view.getUnsigned(value)) return false;
+            setUnsigned(static_cast<Type>(view.tag), value);
+            return true;
+        }
+        case Type::COUNTER64: {
+            uint64_t value;
+            if (!view.getUnsigned64(value)) return false;
+            setCounter64(value);
+            return true;
+        }
+        case Type::IP_ADDRESS:
+            if (view.length != 4) return false;
+            setIpAddress(view.data);
             return true;
         default:
             return false;
@@ -34,231 +81,237 @@ bool ASN1Object::decode(const uint8_t* buffer, uint16_t size, uint16_t& offset)
 }
 
 uint16_t ASN1Object::encode(uint8_t* buffer, uint16_t maxSize) const {
-    if (maxSize < 2) return 0;
-    
-    uint16_t totalLength = 0;
-    
-    // Write type
-    buffer[totalLength++] = static_cast<uint8_t>(type_);
-    
-    // Write value based on type
-    uint16_t valueLength = 0;
+    if (!buffer) return 0;
+    if (type_ == Type::OBJECT_IDENTIFIER && storage_ == Storage::COMPONENTS &&
+        !validArcs(value_.components, length_)) {
+        return 0;
+    }
+
+    size_t valueLength = contentSize();
+    size_t lengthBytes = BERKernel::lengthSize(valueLength);
+    if (1 + lengthBytes + valueLength > maxSize) return 0;
+
+    // Tag, length and content written in place
+    buffer[0] = static_cast<uint8_t>(type_);
+    BERKernel::writeLength(buffer + 1, valueLength);
+    encodeContent(buffer + 1 + lengthBytes);
+
+    return 1 + lengthBytes + valueLength;
+}
+
+uint16_t ASN1Object::encodedSize() const {
+    if (type_ == Type::OBJECT_IDENTIFIER && storage_ == Storage::COMPONENTS &&
+        !validArcs(value_.components, length_)) {
+        return 0;
+    }
+    return BERKernel::tlvSize(contentSize());
+}
+
+bool ASN1Object::encode(BERWriter& writer) const {
+    uint8_t tag = static_cast<uint8_t>(type_);
     switch (type_) {
         case Type::INTEGER:
-            valueLength = encodeInteger(buffer + totalLength + 1, maxSize - totalLength - 1);
-            break;
-        case Type::OCTET_STRING:
-            valueLength = encodeString(buffer + totalLength + 1, maxSize - totalLength - 1);
-            break;
-        case Type::OBJECT_IDENTIFIER:
-            valueLength = encodeOID(buffer + totalLength + 1, maxSize - totalLength - 1);
-            break;
+            return writer.writeInteger(tag, static_cast<int32_t>(value_.integer));
+        case Type::COUNTER32:
+        case Type::GAUGE32:
+        case Type::TIMETICKS:
+            return writer.writeUnsigned(tag, static_cast<uint32_t>(value_.unsignedValue));
+        case Type::COUNTER64:
+            return writer.writeUnsigned64(tag, value_.unsignedValue);
         case Type::NULL_TYPE:
-            valueLength = 0;
-            break;
+            return writer.writeNull();
+        case Type::NO_SUCH_OBJECT:
+        case Type::NO_SUCH_INSTANCE:
+        case Type::END_OF_MIB_VIEW:
+            return writer.writeHeader(tag, 0);
+        case Type::OBJECT_IDENTIFIER:
+            if (storage_ == Storage::COMPONENTS) {
+                return validArcs(value_.components, length_) &&
+                       writer.writeOID(value_.components, length_);
+            }
+            return writer.writeOctetString(tag, getData(), length_);
+        case Type::OCTET_STRING:
+        case Type::SEQUENCE:
+        case Type::IP_ADDRESS:
+            return writer.writeOctetString(tag, getData(), length_);
         default:
-            return 0;
+            return false;
     }
-    
-    // Write length
-    uint16_t lengthBytes = encodeLength(buffer + totalLength, maxSize - totalLength, valueLength);
-    if (lengthBytes == 0) return 0;
-    
-    totalLength += lengthBytes + valueLength;
-    return totalLength;
 }
 
 int32_t ASN1Object::getInteger() const {
-    return (type_ == Type::INTEGER) ? value_.integer : 0;
+    return (type_ == Type::INTEGER) ? static_cast<int32_t>(value_.integer) : 0;
+}
+
+uint32_t ASN1Object::getUnsigned() const {
+    switch (type_) {
+        case Type::COUNTER32:
+        case Type::GAUGE32:
+        case Type::TIMETICKS:
+            return static_cast<uint32_t>(value_.unsignedValue);
+        default:
+            return 0;
+    }
+}
+
+uint64_t ASN1Object::getUnsigned64() const {
+    return (type_ == Type::COUNTER64) ? value_.unsignedValue : getUnsigned();
+}
+
+const uint8_t* ASN1Object::getIpAddress() const {
+    return (type_ == Type::IP_ADDRESS) ? value_.bytes : nullptr;
 }
 
 const char* ASN1Object::getString() const {
-    return (type_ == Type::OCTET_STRING) ? value_.string.text : "";
+    return (type_ == Type::OCTET_STRING) ? reinterpret_cast<const char*>(getData()) : "";
 }
 
 size_t ASN1Object::getStringLength() const {
-    return (type_ == Type::OCTET_STRING) ? value_.string.length : 0;
+    return (type_ == Type::OCTET_STRING) ? length_ : 0;
 }
 
-const uint32_t* ASN1Object::getOID() const {
-    return (type_ == Type::OBJECT_IDENTIFIER) ? value_.oid.components : nullptr;
+bool ASN1Object::getOID(OID& oid) const {
+    if (type_ != Type::OBJECT_IDENTIFIER) return false;
+    if (storage_ == Storage::COMPONENTS) {
+        return OID::fromComponents(value_.components, length_, oid);
+    }
+    return OID::fromEncoded(getData(), length_, oid);
 }
 
-size_t ASN1Object::getOIDLength() const {
-    return (type_ == Type::OBJECT_IDENTIFIER) ? value_.oid.count : 0;
+const uint8_t* ASN1Object::getData() const {
+    switch (storage_) {
+        case Storage::INLINE:
+            return value_.bytes;
+        case Storage::EXTERNAL:
+            return value_.data;
+        default:
+            return nullptr;
+    }
 }
 
 void ASN1Object::setInteger(int32_t value) {
     type_ = Type::INTEGER;
+    storage_ = Storage::SCALAR;
+    length_ = 0;
     value_.integer = value;
 }
 
-void ASN1Object::setString(const char* value, size_t length) {
-    type_ = Type::OCTET_STRING;
-    size_t copyLength = (length < MAX_STRING_LENGTH) ? length : MAX_STRING_LENGTH - 1;
-    memcpy(value_.string.text, value, copyLength);
-    value_.string.text[copyLength] = '\0';
-    value_.string.length = copyLength;
+void ASN1Object::setUnsigned(Type type, uint64_t value) {
+    type_ = type;
+    storage_ = Storage::SCALAR;
+    length_ = 0;
+    value_.unsignedValue = value;
 }
 
-void ASN1Object::setOID(const uint32_t* oid, size_t length) {
-    type_ = Type::OBJECT_IDENTIFIER;
-    size_t copyLength = (length < MAX_OID_LENGTH) ? length : MAX_OID_LENGTH;
-    memcpy(value_.oid.components, oid, copyLength * sizeof(uint32_t));
-    value_.oid.count = copyLength;
+void ASN1Object::setIpAddress(const uint8_t address[4]) {
+    static const uint8_t ANY[4] = {0, 0, 0, 0};
+    setBytes(Type::IP_ADDRESS, address ? address : ANY, 4, true);
 }
 
-bool ASN1Object::decodeLength(const uint8_t* buffer, uint16_t size, uint16_t& offset, uint16_t& length) const {
-    if (offset >= size) return false;
-    
-    uint8_t firstByte = buffer[offset++];
-    if (firstByte < 0x80) {
-        length = firstByte;
-        return true;
-    }
-    
-    uint8_t numBytes = firstByte & 0x7F;
-    if (numBytes > 2 || offset + numBytes > size) return false;
-    
-    length = 0;
-    for (uint8_t i = 0; i < numBytes; i++) {
-        length = (length << 8) | buffer[offset++];
-    }
-    
+bool ASN1Object::setString(const char* value, size_t length) {
+    if (!value || length > INLINE_SIZE) return false;
+    setBytes(Type::OCTET_STRING, reinterpret_cast<const uint8_t*>(value), length, true);
     return true;
 }
 
-uint16_t ASN1Object::encodeLength(uint8_t* buffer, uint16_t maxSize, uint16_t length) const {
-    if (length < 0x80) {
-        if (maxSize < 1) return 0;
-        buffer[0] = length;
-        return 1;
-    }
-    
-    if (length < 0x100) {
-        if (maxSize < 2) return 0;
-        buffer[0] = 0x81;
-        buffer[1] = length;
-        return 2;
-    }
-    
-    if (maxSize < 3) return 0;
-    buffer[0] = 0x82;
-    buffer[1] = (length >> 8) & 0xFF;
-    buffer[2] = length & 0xFF;
-    return 3;
+void ASN1Object::setStringRef(const char* value, size_t length) {
+    setBytes(Type::OCTET_STRING, reinterpret_cast<const uint8_t*>(value), length, false);
 }
 
-bool ASN1Object::decodeInteger(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    uint16_t length;
-    if (!decodeLength(buffer, size, offset, length) || length > 4 || offset + length > size) return false;
-    
-    value_.integer = 0;
-    if (buffer[offset] & 0x80) {
-        value_.integer = -1;  // Sign extend
+bool ASN1Object::setOID(const uint32_t* oid, size_t length) {
+    if (!validArcs(oid, length) || BERKernel::oidContentSize(oid, length) > INLINE_SIZE) {
+        return false;
     }
-    
-    for (uint16_t i = 0; i < length; i++) {
-        value_.integer = (value_.integer << 8) | buffer[offset++];
+
+    type_ = Type::OBJECT_IDENTIFIER;
+    storage_ = Storage::INLINE;
+    uint8_t* out = value_.bytes;
+    out += BERKernel::writeSubidentifier(out, oid[0] * 40 + oid[1]);
+    for (size_t i = 2; i < length; i++) {
+        out += BERKernel::writeSubidentifier(out, oid[i]);
     }
-    
+    length_ = out - value_.bytes;
     return true;
 }
 
-bool ASN1Object::decodeString(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    uint16_t length;
-    if (!decodeLength(buffer, size, offset, length) || offset + length > size) return false;
-    
-    size_t copyLength = (length < MAX_STRING_LENGTH - 1) ? length : MAX_STRING_LENGTH - 1;
-    memcpy(value_.string.text, buffer + offset, copyLength);
-    value_.string.text[copyLength] = '\0';
-    value_.string.length = copyLength;
-    
-    offset += length;
-    return true;
+void ASN1Object::setOIDRef(const uint32_t* oid, size_t length) {
+    type_ = Type::OBJECT_IDENTIFIER;
+    storage_ = Storage::COMPONENTS;
+    value_.components = oid;
+    length_ = oid ? length : 0;
 }
 
-bool ASN1Object::decodeOID(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    uint16_t length;
-    if (!decodeLength(buffer, size, offset, length) || offset + length > size) return false;
-    
-    // First byte encodes first two OID components
-    if (length < 1) return false;
-    uint8_t firstByte = buffer[offset++];
-    value_.oid.components[0] = firstByte / 40;
-    value_.oid.components[1] = firstByte % 40;
-    value_.oid.count = 2;
-    
-    // Decode remaining components
-    uint32_t value = 0;
-    for (uint16_t i = 1; i < length && value_.oid.count < MAX_OID_LENGTH; i++) {
-        uint8_t byte = buffer[offset++];
-        value = (value << 7) | (byte & 0x7F);
-        if ((byte & 0x80) == 0) {
-            value_.oid.components[value_.oid.count++] = value;
-            value = 0;
-        }
-    }
-    
-    return true;
+void ASN1Object::setOIDRef(const OID& oid) {
+    setBytes(Type::OBJECT_IDENTIFIER, oid.getEncoded(), oid.getEncodedLength(), false);
 }
 
-uint16_t ASN1Object::encodeInteger(uint8_t* buffer, uint16_t maxSize) const {
-    // Determine minimum number of bytes needed
-    uint8_t length = 1;
-    int32_t value = value_.integer;
-    while ((value < -128 || value > 127) && length < 4) {
-        length++;
-        value >>= 8;
-    }
-    
-    if (maxSize < length) return 0;
-    
-    // Write integer bytes
-    value = value_.integer;
-    for (int i = length - 1; i >= 0; i--) {
-        buffer[i] = value & 0xFF;
-        value >>= 8;
+void ASN1Object::setSequenceRef(const uint8_t* content, size_t length) {
+    setBytes(Type::SEQUENCE, content, length, false);
+}
+
+void ASN1Object::setBytes(Type type, const uint8_t* data, size_t length, bool copy) {
+    type_ = type;
+    length_ = data ? length : 0;
+    if (copy) {
+        storage_ = Storage::INLINE;
+        memcpy(value_.bytes, data, length_);
+    } else {
+        storage_ = Storage::EXTERNAL;
+        value_.data = data;
     }
-    
-    return length;
 }
 
-uint16_t ASN1Object::encodeString(uint8_t* buffer, uint16_t maxSize) const {
-    if (maxSize < value_.string.length) return 0;
-    
-    memcpy(buffer, value_.string.text, value_.string.length);
-    return value_.string.length;
+size_t ASN1Object::contentSize() const {
+    switch (type_) {
+        case Type::INTEGER:
+            return BERKernel::integerSize(static_cast<int32_t>(value_.integer));
+        case Type::COUNTER32:
+        case Type::GAUGE32:
+        case Type::TIMETICKS:
+            return BERKernel::unsignedSize(static_cast<uint32_t>(value_.unsignedValue));
+        case Type::COUNTER64:
+            return BERKernel::unsignedSize(value_.unsignedValue);
+        case Type::NULL_TYPE:
+            return 0;
+        case Type::OBJECT_IDENTIFIER:
+            if (storage_ == Storage::COMPONENTS) {
+                return BERKernel::oidContentSize(value_.components, length_);
+            }
+            return length_;
+        default:
+            return length_;
+    }
 }
 
-uint16_t ASN1Object::encodeOID(uint8_t* buffer, uint16_t maxSize) const {
-    if (value_.oid.count < 2 || maxSize < 1) return 0;
-    
-    uint16_t length = 0;
-    
-    // Encode first two components in first byte
-    buffer[length++] = (value_.oid.components[0] * 40) + value_.oid.components[1];
-    
-    // Encode remaining components
-    for (size_t i = 2; i < value_.oid.count; i++) {
-        uint32_t value = value_.oid.components[i];
-        uint8_t bytes[5];  // Maximum 5 bytes for 32-bit value
-        int numBytes = 0;
-        
-        // Convert to base-128 encoding
-        do {
-            uint8_t byte = (value & 0x7F) | (numBytes > 0 ? 0x80 : 0);
-            bytes[numBytes] = byte;
-            numBytes++;
-            value >>= 7;
-        } while (value > 0 && numBytes < 5);
-        
-        // Write bytes in reverse order
-        if (length + numBytes > maxSize) return 0;
-        for (int j = numBytes - 1; j >= 0; j--) {
-            buffer[length++] = bytes[j];
-        }
+size_t ASN1Object::encodeContent(uint8_t* buffer) const {
+    switch (type_) {
+        case Type::INTEGER:
+            return BERKernel::writeInteger(buffer, static_cast<int32_t>(value_.integer));
+        case Type::COUNTER32:
+        case Type::GAUGE32:
+        case Type::TIMETICKS:
+            return BERKernel::writeUnsigned(buffer, static_cast<uint32_t>(value_.unsignedValue));
+        case Type::COUNTER64:
+            return BERKernel::writeUnsigned(buffer, value_.unsignedValue);
+        case Type::NULL_TYPE:
+            return 0;
+        case Type::OBJECT_IDENTIFIER:
+            if (storage_ == Storage::COMPONENTS) {
+                const uint32_t* components = value_.components;
+                uint8_t* out = buffer;
+                out += BERKernel::writeSubidentifier(out, components[0] * 40 + components[1]);
+                for (size_t i = 2; i < length_; i++) {
+                    out += BERKernel::writeSubidentifier(out, components[i]);
+                }
+                return out - buffer;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (length_ > 0) {
+        memcpy(buffer, getData(), length_);
     }
-    
-    return length;
+    return length_;
 }
@@ -0,0 +1,6 @@
+#include "BERConstant.h"
+
+void invalidBERConstant() {
+    // Only reachable at runtime for values built outside a constant
+    // expression; the value is left empty and callers check isValid().
+}
@@ -0,0 +1,181 @@
+#include "BERStream.h"
+#include <string.h>
+
+BERStreamParser::BERStreamParser(const Handler& handler)
+    : handler_(handler)
+{
+    reset();
+}
+
+void BERStreamParser::reset() {
+    state_ = State::TAG;
+    mode_ = ContentMode::DIRECT;
+    tag_ = 0;
+    lengthOctets_ = 0;
+    depth_ = 0;
+    length_ = 0;
+    contentSeen_ = 0;
+    position_ = 0;
+    contentStart_ = nullptr;
+    inputEnd_ = nullptr;
+}
+
+bool BERStreamParser::feed(const uint8_t* chunk, uint16_t size) {
+    if (state_ == State::ERROR) return false;
+    if (size == 0) return true;
+    if (!chunk) return fail();
+
+    // Content cut by a discontinuity can no longer be delivered in place
+    bool contiguous = (chunk == inputEnd_);
+    inputEnd_ = chunk + size;
+    if (state_ == State::CONTENT && !contiguous && !splitContent()) {
+        return fail();
+    }
+
+    uint16_t i = 0;
+    while (i < size) {
+        switch (state_) {
+            case State::TAG:
+                tag_ = chunk[i++];
+                position_++;
+                state_ = State::LENGTH;
+                break;
+
+            case State::LENGTH: {
+                uint8_t octet = chunk[i++];
+                position_++;
+                if (octet & 0x80) {
+                    // Long form, up to two length octets
+                    lengthOctets_ = octet & 0x7F;
+                    if (lengthOctets_ == 0 || lengthOctets_ > 2) return fail();
+                    length_ = 0;
+                    state_ = State::LENGTH_OCTETS;
+                } else {
+                    length_ = octet;
+                    if (!beginElement(chunk + i)) return fail();
+                }
+                break;
+            }
+
+            case State::LENGTH_OCTETS:
+                length_ = (length_ << 8) | chunk[i++];
+                position_++;
+                if (--lengthOctets_ == 0 && !beginElement(chunk + i)) return fail();
+                break;
+
+            case State::CONTENT: {
+                uint16_t used = 0;
+                if (!consumeContent(chunk + i, size - i, used)) return fail();
+                i += used;
+                break;
+            }
+
+            case State::DONE:
+                return true;
+
+            case State::ERROR:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool BERStreamParser::beginElement(const uint8_t* at) {
+    // Children must fit inside their parent
+    if (depth_ > 0 && position_ + length_ > frames_[depth_ - 1].end) {
+        return false;
+    }
+
+    if (tag_ & 0x20) {
+        if (depth_ >= MAX_DEPTH) return false;
+        frames_[depth_].tag = tag_;
+        frames_[depth_].end = position_ + length_;
+        if (!handler_.onConstructed(handler_.context, tag_, length_, depth_)) return false;
+        depth_++;
+        return finishElement();
+    }
+
+    if (length_ == 0) {
+        // Nothing to gather; point at the current input position
+        if (!handler_.onPrimitive(handler_.context, tag_, at, 0, depth_, false, false)) return false;
+        return finishElement();
+    }
+
+    state_ = State::CONTENT;
+    mode_ = ContentMode::DIRECT;
+    contentSeen_ = 0;
+    contentStart_ = nullptr;
+    return true;
+}
+
+bool BERStreamParser::consumeContent(const uint8_t* data, uint16_t available, uint16_t& used) {
+    if (contentSeen_ == 0 && mode_ == ContentMode::DIRECT) {
+        contentStart_ = data;
+    }
+
+    uint16_t remaining = length_ - contentSeen_;
+    used = (available < remaining) ? available : remaining;
+
+    if (mode_ == ContentMode::CARRY) {
+        memcpy(carry_ + contentSeen_, data, used);
+    }
+    contentSeen_ += used;
+    position_ += used;
+    bool last = (contentSeen_ == length_);
+
+    switch (mode_) {
+        case ContentMode::DIRECT:
+            if (last && !handler_.onPrimitive(handler_.context, tag_, contentStart_, length_,
+                                              depth_, false, false)) {
+                return false;
+            }
+            break;
+        case ContentMode::CARRY:
+            if (last && !handler_.onPrimitive(handler_.context, tag_, carry_, length_,
+                                              depth_, true, false)) {
+                return false;
+            }
+            break;
+        case ContentMode::PIECES:
+            if (!handler_.onPrimitive(handler_.context, tag_, data, used, depth_, false, !last)) {
+                return false;
+            }
+            break;
+    }
+
+    return !last || finishElement();
+}
+
+bool BERStreamParser::splitContent() {
+    if (mode_ != ContentMode::DIRECT || contentSeen_ == 0) {
+        return true;
+    }
+
+    // Gather short content; hand longer content over piece by piece
+    if (length_ <= CARRY_SIZE) {
+        memcpy(carry_, contentStart_, contentSeen_);
+        mode_ = ContentMode::CARRY;
+        return true;
+    }
+
+    mode_ = ContentMode::PIECES;
+    return handler_.onPrimitive(handler_.context, tag_, contentStart_, contentSeen_,
+                                depth_, false, true);
+}
+
+bool BERStreamParser::finishElement() {
+    // Close every constructed element that ends here
+    while (depth_ > 0 && frames_[depth_ - 1].end == position_) {
+        depth_--;
+        if (!handler_.onEnd(handler_.context, frames_[depth_].tag, depth_)) return false;
+    }
+
+    state_ = (depth_ == 0) ? State::DONE : State::TAG;
+    return true;
+}
+
+bool BERStreamParser::fail() {
+    state_ = State::ERROR;
+    return false;
+}
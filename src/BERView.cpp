@@ -0,0 +1,122 @@
+#include "BERView.h"
+
+bool BERView::getInteger(int32_t& value) const {
+    if (!data || length < 1 || length > 4) return false;
+
+    // Sign extend from the first content octet
+    int32_t result = (data[0] & 0x80) ? -1 : 0;
+    for (uint16_t i = 0; i < length; i++) {
+        result = static_cast<int32_t>((static_cast<uint32_t>(result) << 8) | data[i]);
+    }
+
+    value = result;
+    return true;
+}
+
+bool BERView::getUnsigned(uint32_t& value) const {
+    if (!data || length < 1 || length > 5) return false;
+
+    // A fifth octet is only allowed as a leading zero
+    if (length == 5 && data[0] != 0) return false;
+
+    uint32_t result = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        result = (result << 8) | data[i];
+    }
+
+    value = result;
+    return true;
+}
+
+bool BERView::getUnsigned64(uint64_t& value) const {
+    if (!data || length < 1 || length > 9) return false;
+
+    // A ninth octet is only allowed as a leading zero
+    if (length == 9 && data[0] != 0) return false;
+
+    uint64_t result = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        result = (result << 8) | data[i];
+    }
+
+    value = result;
+    return true;
+}
+
+bool BERView::getOID(uint32_t* components, size_t& count, size_t maxCount) const {
+    if (!data || !components || length < 1 || maxCount < 2) return false;
+
+    count = 0;
+    uint32_t value = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        value = (value << 7) | (data[i] & 0x7F);
+        if (data[i] & 0x80) {
+            continue;
+        }
+
+        if (count == 0) {
+            // First sub-identifier packs the first two arcs
+            components[0] = (value < 80) ? value / 40 : 2;
+            components[1] = (value < 80) ? value % 40 : value - 80;
+            count = 2;
+        } else {
+            if (count >= maxCount) return false;
+            components[count++] = value;
+        }
+        value = 0;
+    }
+
+    // Last octet must terminate a sub-identifier
+    return (data[length - 1] & 0x80) == 0;
+}
+
+BERReader::BERReader(const uint8_t* buffer, uint16_t size)
+    : buffer_(buffer)
+    , size_(buffer ? size : 0)
+    , offset_(0)
+{
+}
+
+BERReader::BERReader(const BERView& constructed)
+    : buffer_(constructed.data)
+    , size_(constructed.data ? constructed.length : 0)
+    , offset_(0)
+{
+}
+
+bool BERReader::read(BERView& element) {
+    if (offset_ + 2 > size_) return false;
+
+    uint16_t offset = offset_;
+    uint8_t tag = buffer_[offset++];
+
+    // Definite length, short or long form (up to two length octets)
+    uint16_t length = buffer_[offset++];
+    if (length & 0x80) {
+        uint8_t numBytes = length & 0x7F;
+        if (numBytes == 0 || numBytes > 2 || offset + numBytes > size_) return false;
+
+        length = 0;
+        for (uint8_t i = 0; i < numBytes; i++) {
+            length = (length << 8) | buffer_[offset++];
+        }
+    }
+
+    if (length > size_ - offset) return false;
+
+    element.tag = tag;
+    element.data = buffer_ + offset;
+    element.length = length;
+    offset_ = offset + length;
+    return true;
+}
+
+bool BERReader::read(uint8_t expectedTag, BERView& element) {
+    BERView candidate;
+    if (!read(candidate) || candidate.tag != expectedTag) {
+        return false;
+    }
+
+    element = candidate;
+    return true;
+}
@@ -0,0 +1,99 @@
+#include "BERWriter.h"
+#include "BERKernels.h"
+#include <string.h>
+
+BERWriter::BERWriter(uint8_t* buffer, uint16_t size)
+    : buffer_(buffer)
+    , capacity_(buffer ? size : 0)
+    , position_(buffer ? size : 0)
+    , overflow_(buffer == nullptr)
+{
+}
+
+bool BERWriter::reserve(uint16_t length) {
+    if (overflow_ || length > position_) {
+        overflow_ = true;
+        return false;
+    }
+    position_ -= length;
+    return true;
+}
+
+bool BERWriter::writeByte(uint8_t byte) {
+    if (!reserve(1)) return false;
+    buffer_[position_] = byte;
+    return true;
+}
+
+bool BERWriter::writeBytes(const uint8_t* data, uint16_t length) {
+    if (!reserve(length)) return false;
+    if (length > 0) {
+        memmove(buffer_ + position_, data, length);
+    }
+    return true;
+}
+
+bool BERWriter::writeLength(uint16_t length) {
+    if (!reserve(BERKernel::lengthSize(length))) return false;
+    BERKernel::writeLength(buffer_ + position_, length);
+    return true;
+}
+
+bool BERWriter::writeHeader(uint8_t tag, uint16_t length) {
+    return writeLength(length) && writeByte(tag);
+}
+
+bool BERWriter::writeInteger(uint8_t tag, int32_t value) {
+    uint8_t length = BERKernel::integerSize(value);
+    if (!reserve(length)) return false;
+    BERKernel::writeInteger(buffer_ + position_, value);
+    return writeHeader(tag, length);
+}
+
+bool BERWriter::writeUnsigned(uint8_t tag, uint32_t value) {
+    uint8_t length = BERKernel::unsignedSize(value);
+    if (!reserve(length)) return false;
+    BERKernel::writeUnsigned(buffer_ + position_, value);
+    return writeHeader(tag, length);
+}
+
+bool BERWriter::writeUnsigned64(uint8_t tag, uint64_t value) {
+    uint8_t length = BERKernel::unsignedSize(value);
+    if (!reserve(length)) return false;
+    BERKernel::writeUnsigned(buffer_ + position_, value);
+    return writeHeader(tag, length);
+}
+
+bool BERWriter::writeOctetString(uint8_t tag, const uint8_t* data, uint16_t length) {
+    return writeBytes(data, length) && writeHeader(tag, length);
+}
+
+bool BERWriter::writeNull() {
+    return writeHeader(0x05, 0);
+}
+
+bool BERWriter::writeOID(const uint32_t* components, size_t count) {
+    if (!components || count < 2) {
+        overflow_ = true;
+        return false;
+    }
+
+    uint16_t start = size();
+
+    // Sub-identifiers from last to first, each written in its final order
+    for (size_t i = count; i-- > 1;) {
+        uint32_t value = (i == 1) ? components[0] * 40 + components[1] : components[i];
+        if (!reserve(BERKernel::subidentifierSize(value))) return false;
+        BERKernel::writeSubidentifier(buffer_ + position_, value);
+    }
+
+    return writeHeader(0x06, size() - start);
+}
+
+bool BERWriter::endConstructed(uint8_t tag, uint16_t mark) {
+    if (overflow_ || mark > size()) {
+        overflow_ = true;
+        return false;
+    }
+    return writeHeader(tag, size() - mark);
+}
@@ -65,9 +65,15 @@ void CLI::parseCommand() {
         if (strcmp(argv[1], "community") == 0) {
             handleSetCommunity(argv[2]);
         }
+        else if (strcmp(argv[1], "write-community") == 0) {
+            handleSetWriteCommunity(argv[2]);
+        }
         else if (strcmp(argv[1], "network") == 0) {
             handleSetNetwork(argc - 2, &argv[2]);
         }
+        else if (strcmp(argv[1], "trap") == 0) {
+            handleSetTrap(argc - 2, &argv[2]);
+        }
         else {
             printError("Unknown setting");
         }
@@ -99,7 +105,9 @@ void CLI::handleHelp() {
     serialCom.sendln("Available commands:");
     printCommandHelp("help", "help", "Show this help message");
     printCommandHelp("set community", "set community <string>", "Set SNMP community string");
+    printCommandHelp("set write-community", "set write-community <string|off>", "Allow SET with this community");
     printCommandHelp("set network", "set network <dhcp|static> [ip] [mask] [gateway]", "Configure network settings");
+    printCommandHelp("set trap", "set trap <ip|off> [inform]", "Send notifications to a manager (after restart)");
     printCommandHelp("status", "status", "Show current device status");
     printCommandHelp("factory-reset", "factory-reset", "Reset device to factory settings");
 }
@@ -121,6 +129,22 @@ void CLI::handleSetCommunity(const char* community) {
     }
 }
 
+void CLI::handleSetWriteCommunity(const char* community) {
+    // "off" clears it: SET is then refused whatever the community
+    if (strcmp(community, "off") == 0) {
+        community = "";
+    } else if (!isValidCommunity(community)) {
+        printError("Invalid community string (1-31 chars, alphanumeric and -_)");
+        return;
+    }
+    
+    if (settings.setWriteCommunity(community)) {
+        printSuccess(community[0] ? "Write community updated" : "SET disabled");
+    } else {
+        printError("Failed to update write community");
+    }
+}
+
 void CLI::handleSetNetwork(int argc, char* argv[]) {
     if (argc < 1) {
         printError("Missing network mode");
@@ -171,11 +195,40 @@ void CLI::handleSetNetwork(int argc, char* argv[]) {
     }
 }
 
+void CLI::handleSetTrap(int argc, char* argv[]) {
+    uint8_t host[4] = {0, 0, 0, 0};
+    bool inform = false;
+    
+    if (strcmp(argv[0], "off") != 0) {
+        if (!isValidIPAddress(argv[0])) {
+            printError("Invalid IP address format");
+            return;
+        }
+        sscanf(argv[0], "%hhu.%hhu.%hhu.%hhu", &host[0], &host[1], &host[2], &host[3]);
+        
+        if (argc > 1) {
+            if (strcmp(argv[1], "inform") != 0) {
+                printError("Usage: set trap <ip|off> [inform]");
+                return;
+            }
+            inform = true;
+        }
+    }
+    
+    if (settings.setTrapDestination(host, inform)) {
+        printSuccess("Trap destination updated; takes effect after restart");
+    } else {
+        printError("Failed to save trap destination");
+    }
+}
+
 void CLI::handleStatus() {
     const DeviceSettings& config = settings.getSettings();
     
     serialCom.sendln("\nDevice Status:");
     serialCom.printf("Community String: %s\n", config.communityString);
+    serialCom.printf("Write Community: %s\n",
+                     config.writeCommunity[0] ? config.writeCommunity : "off (SET disabled)");
     serialCom.printf("Network Mode: %s\n", config.dhcpEnabled ? "DHCP" : "Static");
     
     if (!config.dhcpEnabled) {
@@ -188,6 +241,9 @@ void CLI::handleStatus() {
     }
     
     serialCom.printf("SNMP Port: %d\n", config.snmpPort);
+    serialCom.printf("Trap Destination: %d.%d.%d.%d (%s)\n",
+        config.trapHost[0], config.trapHost[1], config.trapHost[2], config.trapHost[3],
+        config.trapInform ? "inform" : "trap");
     serialCom.printf("Power Loss Count: %lu\n", config.powerLossCount);
     serialCom.printf("Uptime: %lu seconds\n", config.uptime);
     serialCom.sendln("");
@@ -1,110 +1,309 @@
 #include "MIB.h"
+#include "BERView.h"
 #include "ErrorHandler.h"
 #include <string.h>
-#include <stdlib.h>
 
-MIB::MIB() : node_count_(0) {
+MIB::MIB() : node_count_(0), transaction_{nullptr, nullptr, nullptr}, generation_(0),
+             volatileReads_(0) {
 }
 
-bool MIB::registerNode(const char* oid, NodeType type, Access access,
-                      GetterFunction getter, SetterFunction setter) {
-    if (!isValidOID(oid) || node_count_ >= MAX_NODES) {
+bool MIB::registerNode(const OID& oid, NodeType type, Access access,
+                      GetterFunction getter, SetterFunction setter,
+                      ValidatorFunction validator) {
+    Node node;
+    node.type = type;
+    node.access = access;
+    node.getter = getter;
+    node.setter = setter;
+    node.validator = validator;
+    node.constant = nullptr;
+    node.isVolatile = false;
+    memcpy(node.oid, oid.getEncoded(), oid.getEncodedLength());
+    node.oidLength = oid.getEncodedLength();
+    
+    if (!oid.isValid() || !addNode(node)) {
         REPORT_ERROR(ErrorHandler::Severity::WARNING,
                     ErrorHandler::Category::PROTOCOL,
                     0x6001,
                     "Invalid OID format or MIB full");
         return false;
     }
-    
+    return true;
+}
+
+bool MIB::registerNode(const OID& oid, NodeType type, const BERConstant& value) {
     Node node;
     node.type = type;
-    node.access = access;
-    node.getter = getter;
-    node.setter = setter;
-    strncpy(node.oid, oid, sizeof(node.oid) - 1);
-    node.oid[sizeof(node.oid) - 1] = '\0';
+    node.access = Access::READ_ONLY;
+    node.getter = nullptr;
+    node.setter = nullptr;
+    node.validator = nullptr;
+    node.constant = &value;
+    node.isVolatile = false;
+    memcpy(node.oid, oid.getEncoded(), oid.getEncodedLength());
+    node.oidLength = oid.getEncodedLength();
     
-    return addNode(node);
+    if (!oid.isValid() || !value.isValid() || !addNode(node)) {
+        REPORT_ERROR(ErrorHandler::Severity::WARNING,
+                    ErrorHandler::Category::PROTOCOL,
+                    0x6001,
+                    "Invalid OID format or MIB full");
+        return false;
+    }
+    return true;
 }
 
-bool MIB::getValue(const char* oid, ASN1Object& value) const {
-    const Node* node = findNode(oid);
-    if (!node || node->access == Access::NOT_ACCESSIBLE || !node->getter) {
+bool MIB::setVolatile(const OID& oid) {
+    Node* node = findNode(oid.getEncoded(), oid.getEncodedLength());
+    if (!node || !node->getter) {
         return false;
     }
-    
-    value = node->getter();
+    node->isVolatile = true;
     return true;
 }
 
+bool MIB::registerNode(const char* oid, NodeType type, Access access,
+                      GetterFunction getter, SetterFunction setter,
+                      ValidatorFunction validator) {
+    // Text OIDs are parsed once, here; the MIB only keeps encoded bytes
+    OID parsed;
+    OID::parse(oid, parsed);
+    return registerNode(parsed, type, access, getter, setter, validator);
+}
+
+bool MIB::getValue(const OID& oid, ASN1Object& value) const {
+    return getValue(oid.getEncoded(), oid.getEncodedLength(), value);
+}
+
+bool MIB::setValue(const OID& oid, const ASN1Object& value) {
+    return setValue(oid.getEncoded(), oid.getEncodedLength(), value);
+}
+
+bool MIB::getValue(const char* oid, ASN1Object& value) const {
+    OID parsed;
+    return OID::parse(oid, parsed) && getValue(parsed, value);
+}
+
 bool MIB::setValue(const char* oid, const ASN1Object& value) {
-    Node* node = findNode(oid);
-    if (!node || node->access != Access::READ_WRITE || !node->setter) {
+    OID parsed;
+    return OID::parse(oid, parsed) && setValue(parsed, value);
+}
+
+bool MIB::getValue(const uint8_t* oid, size_t length, ASN1Object& value) const {
+    const Node* node = findNode(oid, length);
+    return node && getValue(*node, value);
+}
+
+bool MIB::getValue(const Node& node, ASN1Object& value) const {
+    if (node.access == Access::NOT_ACCESSIBLE) {
+        return false;
+    }
+    if (node.constant) {
+        // Zero-copy: strings and OIDs refer to the constant's bytes
+        BERReader reader(node.constant->data(), node.constant->size());
+        BERView view;
+        return reader.read(view) && value.decode(view);
+    }
+    if (!node.getter) {
         return false;
     }
     
-    return node->setter(value);
+    if (node.isVolatile) {
+        volatileReads_++;
+    }
+    value = node.getter();
+    return true;
 }
 
-bool MIB::getNextOID(const char* oid, char* nextOid, size_t maxLength) const {
-    if (!oid || !nextOid || maxLength == 0) {
+bool MIB::getEncodedValue(const uint8_t* oid, size_t length,
+                          const uint8_t*& value, uint16_t& size) const {
+    const Node* node = findNode(oid, length);
+    return node && getEncodedValue(*node, value, size);
+}
+
+bool MIB::getEncodedValue(const Node& node, const uint8_t*& value, uint16_t& size) const {
+    if (node.access == Access::NOT_ACCESSIBLE || !node.constant) {
+        return false;
+    }
+    value = node.constant->data();
+    size = node.constant->size();
+    return true;
+}
+
+bool MIB::findNodes(Lookup* lookups, size_t count, bool next) const {
+    if (count > MAX_LOOKUPS) {
         return false;
     }
     
-    // Handle empty OID
-    if (oid[0] == '\0') {
-        if (node_count_ > 0) {
-            strncpy(nextOid, nodes_[0].oid, maxLength - 1);
-            nextOid[maxLength - 1] = '\0';
-            return true;
+    // Request positions in OID order; insertion sort, as requests are short
+    uint8_t order[MAX_LOOKUPS];
+    for (size_t i = 0; i < count; i++) {
+        size_t j = i;
+        while (j > 0 && compareOID(lookups[order[j - 1]].oid, lookups[order[j - 1]].length,
+                                   lookups[i].oid, lookups[i].length) > 0) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = static_cast<uint8_t>(i);
+    }
+    
+    // Merge against the nodes: bounds only move forward
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        Lookup& lookup = lookups[order[i]];
+        pos = upperBound(lookup.oid, lookup.length, pos);
+        lookup.node = nullptr;
+        if (next) {
+            if (pos < node_count_) {
+                lookup.node = &nodes_[pos];
+            }
+        } else if (pos > 0) {
+            const Node& node = nodes_[pos - 1];
+            if (node.oidLength == lookup.length && memcmp(node.oid, lookup.oid, lookup.length) == 0) {
+                lookup.node = &node;
+            }
         }
+    }
+    return true;
+}
+
+bool MIB::setValue(const uint8_t* oid, size_t length, const ASN1Object& value) {
+    Node* node = findNode(oid, length);
+    if (!node || node->access != Access::READ_WRITE || !node->setter) {
         return false;
     }
     
+    if (!node->setter(value)) {
+        return false;
+    }
+    markChanged();
+    return true;
+}
+
+// ASN.1 type a node of the given type accepts
+static ASN1Object::Type valueType(MIB::NodeType type) {
+    switch (type) {
+        case MIB::NodeType::INTEGER: return ASN1Object::Type::INTEGER;
+        case MIB::NodeType::STRING: return ASN1Object::Type::OCTET_STRING;
+        case MIB::NodeType::OID: return ASN1Object::Type::OBJECT_IDENTIFIER;
+        case MIB::NodeType::SEQUENCE: return ASN1Object::Type::SEQUENCE;
+        case MIB::NodeType::IP_ADDRESS: return ASN1Object::Type::IP_ADDRESS;
+        case MIB::NodeType::COUNTER32: return ASN1Object::Type::COUNTER32;
+        case MIB::NodeType::GAUGE32: return ASN1Object::Type::GAUGE32;
+        case MIB::NodeType::TIMETICKS: return ASN1Object::Type::TIMETICKS;
+        case MIB::NodeType::COUNTER64: return ASN1Object::Type::COUNTER64;
+        case MIB::NodeType::NULL_TYPE:
+        default: return ASN1Object::Type::NULL_TYPE;
+    }
+}
+
+MIB::SetError MIB::testValue(const uint8_t* oid, size_t length, const ASN1Object& value) const {
+    const Node* node = findNode(oid, length);
+    if (!node) {
+        return SetError::NO_CREATION;     // Rows are never created
+    }
+    if (node->access != Access::READ_WRITE || !node->setter) {
+        return SetError::NOT_WRITABLE;
+    }
+    if (value.getType() != valueType(node->type)) {
+        return SetError::WRONG_TYPE;
+    }
+    if (node->validator && !node->validator(value)) {
+        return SetError::WRONG_VALUE;
+    }
+    return SetError::NONE;
+}
+
+void MIB::beginSet() {
+    if (transaction_.begin) {
+        transaction_.begin();
+    }
+}
+
+bool MIB::commitSet() {
+    return !transaction_.commit || transaction_.commit();
+}
+
+bool MIB::abortSet() {
+    if (!transaction_.abort) {
+        return false;
+    }
+    transaction_.abort();
+    return true;
+}
+
+bool MIB::getNextOID(const OID& oid, OID& nextOid) const {
+    // An invalid OID starts the walk at the first node
+    const uint8_t* next;
+    size_t nextLength;
+    size_t length = oid.isValid() ? oid.getEncodedLength() : 0;
+    return getNextOID(oid.getEncoded(), length, next, nextLength) &&
+           OID::fromEncoded(next, nextLength, nextOid);
+}
+
+bool MIB::getNextOID(const uint8_t* oid, size_t length,
+                     const uint8_t*& nextOid, size_t& nextLength) const {
     // Find next OID in lexicographical order
-    for (size_t i = 0; i < node_count_; i++) {
-        if (compareOID(oid, nodes_[i].oid) < 0) {
-            strncpy(nextOid, nodes_[i].oid, maxLength - 1);
-            nextOid[maxLength - 1] = '\0';
-            return true;
-        }
+    size_t pos = upperBound(oid, length);
+    if (pos >= node_count_) {
+        return false;
     }
     
-    return false;
+    nextOid = nodes_[pos].oid;
+    nextLength = nodes_[pos].oidLength;
+    return true;
 }
 
-bool MIB::isValidOID(const char* oid) const {
-    if (!oid || oid[0] == '\0') {
+bool MIB::getNextOID(const char* oid, char* nextOid, size_t maxLength) const {
+    if (!oid || !nextOid || maxLength == 0) {
+        return false;
+    }
+    
+    // An empty OID starts the walk at the first node
+    OID current;
+    if (oid[0] != '\0' && !OID::parse(oid, current)) {
         return false;
     }
     
-    const char* ptr = oid;
-    bool first = true;
+    OID next;
+    return getNextOID(current, next) && next.toString(nextOid, maxLength);
+}
+
+bool MIB::isValidOID(const char* oid) const {
+    OID parsed;
+    return OID::parse(oid, parsed);
+}
+
+ASN1Object::Type MIB::getException(const uint8_t* oid, size_t length) const {
+    if (findNode(oid, length)) {
+        return ASN1Object::Type::NO_SUCH_OBJECT;     // Present, not readable
+    }
+    
+    size_t next = upperBound(oid, length);
     
-    while (*ptr) {
-        // Skip dots
-        if (*ptr == '.') {
-            ptr++;
-            continue;
-        }
-        
-        // Parse number
-        char* end;
-        long num = strtol(ptr, &end, 10);
-        if (end == ptr || num < 0) {
-            return false;
+    // A node before the name whose object is a prefix of it
+    if (next > 0) {
+        const Node& before = nodes_[next - 1];
+        size_t objectLength = before.oidLength;
+        bool instanceZero = objectLength >= 2 && before.oid[objectLength - 1] == 0 &&
+                            !(before.oid[objectLength - 2] & 0x80);
+        if (instanceZero) {
+            objectLength--;
         }
-        
-        // First number must be 0-2
-        if (first && num > 2) {
-            return false;
+        if (objectLength < length && memcmp(before.oid, oid, objectLength) == 0) {
+            return ASN1Object::Type::NO_SUCH_INSTANCE;
         }
-        first = false;
-        
-        ptr = end;
     }
     
-    return true;
+    // The object name itself, when its .0 instance is registered
+    if (next < node_count_) {
+        const Node& after = nodes_[next];
+        if (after.oidLength == length + 1 && after.oid[length] == 0 &&
+            memcmp(after.oid, oid, length) == 0) {
+            return ASN1Object::Type::NO_SUCH_INSTANCE;
+        }
+    }
+    return ASN1Object::Type::NO_SUCH_OBJECT;
 }
 
 void MIB::initialize() {
@@ -113,105 +312,76 @@ void MIB::initialize() {
 
 void MIB::initializeSystemGroup() {
     // System group (.1.3.6.1.2.1.1)
-    const char* systemPrefix = "1.3.6.1.2.1.1";
-    char oidBuffer[MAX_OID_STRING_LENGTH];
+    static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+    static constexpr OID SYS_OBJECT_ID_OID{"1.3.6.1.2.1.1.2"};
+    static constexpr OID SYS_UPTIME_OID{"1.3.6.1.2.1.1.3"};
+    static constexpr OID SYS_CONTACT_OID{"1.3.6.1.2.1.1.4"};
+    static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+    static constexpr OID SYS_LOCATION_OID{"1.3.6.1.2.1.1.6"};
+    
+    // Values that never change are encoded once, at compile time
+    static constexpr BERConstant SYS_DESCR = BERConstant::string("SNMP Power Monitor v1.0");
+    static constexpr BERConstant SYS_OBJECT_ID = BERConstant::oid(OID{"1.3.6.1.4.1.63050.1"});
+    static constexpr BERConstant SYS_CONTACT = BERConstant::string("admin@example.com");
+    static constexpr BERConstant SYS_NAME = BERConstant::string("PowerMonitor");
+    static constexpr BERConstant SYS_LOCATION = BERConstant::string("Server Room");
     
     // sysDescr (.1.3.6.1.2.1.1.1)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.1", systemPrefix);
-    registerNode(oidBuffer, NodeType::STRING, Access::READ_ONLY,
-        []() {
-            ASN1Object value(ASN1Object::Type::OCTET_STRING);
-            value.setString("SNMP Power Monitor v1.0", strlen("SNMP Power Monitor v1.0"));
-            return value;
-        });
+    registerNode(SYS_DESCR_OID, NodeType::STRING, SYS_DESCR);
     
     // sysObjectID (.1.3.6.1.2.1.1.2)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.2", systemPrefix);
-    registerNode(oidBuffer, NodeType::OID, Access::READ_ONLY,
-        []() {
-            ASN1Object value(ASN1Object::Type::OBJECT_IDENTIFIER);
-            uint32_t enterpriseOid[] = {1, 3, 6, 1, 4, 1, 63050, 1};
-            value.setOID(enterpriseOid, 8);
-            return value;
-        });
+    registerNode(SYS_OBJECT_ID_OID, NodeType::OID, SYS_OBJECT_ID);
     
     // sysUpTime (.1.3.6.1.2.1.1.3)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.3", systemPrefix);
-    registerNode(oidBuffer, NodeType::INTEGER, Access::READ_ONLY,
+    registerNode(SYS_UPTIME_OID, NodeType::TIMETICKS, Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(millis() / 10); // Convert to hundredths of a second
+            ASN1Object value(ASN1Object::Type::TIMETICKS);
+            value.setTimeTicks(millis() / 10); // Convert to hundredths of a second
             return value;
         });
+    setVolatile(SYS_UPTIME_OID);
+    
+    // sysContact, sysName and sysLocation are read-only defaults here;
+    // SettingsManager::registerMIBNodes() replaces them with writable,
+    // persistent nodes
     
     // sysContact (.1.3.6.1.2.1.1.4)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.4", systemPrefix);
-    registerNode(oidBuffer, NodeType::STRING, Access::READ_WRITE,
-        []() {
-            ASN1Object value(ASN1Object::Type::OCTET_STRING);
-            value.setString("admin@example.com", strlen("admin@example.com"));
-            return value;
-        },
-        [](const ASN1Object& value) {
-            // TODO: Store contact in settings
-            return true;
-        });
+    registerNode(SYS_CONTACT_OID, NodeType::STRING, SYS_CONTACT);
     
     // sysName (.1.3.6.1.2.1.1.5)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.5", systemPrefix);
-    registerNode(oidBuffer, NodeType::STRING, Access::READ_WRITE,
-        []() {
-            ASN1Object value(ASN1Object::Type::OCTET_STRING);
-            value.setString("PowerMonitor", strlen("PowerMonitor"));
-            return value;
-        },
-        [](const ASN1Object& value) {
-            // TODO: Store name in settings
-            return true;
-        });
+    registerNode(SYS_NAME_OID, NodeType::STRING, SYS_NAME);
     
     // sysLocation (.1.3.6.1.2.1.1.6)
-    snprintf(oidBuffer, sizeof(oidBuffer), "%s.6", systemPrefix);
-    registerNode(oidBuffer, NodeType::STRING, Access::READ_WRITE,
-        []() {
-            ASN1Object value(ASN1Object::Type::OCTET_STRING);
-            value.setString("Server Room", strlen("Server Room"));
-            return value;
-        },
-        [](const ASN1Object& value) {
-            // TODO: Store location in settings
-            return true;
-        });
+    registerNode(SYS_LOCATION_OID, NodeType::STRING, SYS_LOCATION);
 }
 
-int MIB::compareOID(const char* oid1, const char* oid2) {
-    const char *p1 = oid1, *p2 = oid2;
-    
-    while (*p1 && *p2) {
-        // Skip dots
-        while (*p1 == '.') p1++;
-        while (*p2 == '.') p2++;
-        
-        if (!*p1 || !*p2) break;
-        
-        // Compare numbers
-        char* end1;
-        char* end2;
-        long num1 = strtol(p1, &end1, 10);
-        long num2 = strtol(p2, &end2, 10);
-        
-        if (num1 != num2) {
-            return num1 - num2;
-        }
-        
-        p1 = end1;
-        p2 = end2;
+int MIB::compareOID(const uint8_t* oid1, size_t length1,
+                    const uint8_t* oid2, size_t length2) {
+    // Skip the common prefix byte by byte
+    size_t common = (length1 < length2) ? length1 : length2;
+    size_t i = 0;
+    while (i < common && oid1[i] == oid2[i]) {
+        i++;
     }
     
-    // Handle case where one OID is prefix of the other
-    if (*p1) return 1;
-    if (*p2) return -1;
-    return 0;
+    // One OID is a prefix of the other
+    if (i == common) {
+        if (length1 == length2) return 0;
+        return (length1 < length2) ? -1 : 1;
+    }
+    
+    // Both differ inside sub-identifiers that start at the same offset.
+    // Base-128 has no leading zero groups, so the sub-identifier with more
+    // octets is larger; with equal octet counts the differing octet decides.
+    size_t end1 = i;
+    while (end1 < length1 && (oid1[end1] & 0x80)) end1++;
+    size_t end2 = i;
+    while (end2 < length2 && (oid2[end2] & 0x80)) end2++;
+    
+    if (end1 != end2) {
+        return (end1 < end2) ? -1 : 1;
+    }
+    return (oid1[i] < oid2[i]) ? -1 : 1;
 }
 
 bool MIB::getParentOID(const char* oid, char* parent, size_t maxLength) {
@@ -247,28 +417,78 @@ bool MIB::isChildOID(const char* parent, const char* child) {
     return strncmp(parent, child, parentLen) == 0 && child[parentLen] == '.';
 }
 
-const MIB::Node* MIB::findNode(const char* oid) const {
-    for (size_t i = 0; i < node_count_; i++) {
-        if (strcmp(nodes_[i].oid, oid) == 0) {
-            return &nodes_[i];
-        }
+const MIB::Node* MIB::findNode(const uint8_t* oid, size_t length) const {
+    // Nodes are sorted, so the match is the last node not after oid
+    size_t pos = upperBound(oid, length);
+    if (pos == 0) {
+        return nullptr;
+    }
+    
+    const Node& node = nodes_[pos - 1];
+    if (node.oidLength == length && memcmp(node.oid, oid, length) == 0) {
+        return &node;
     }
     return nullptr;
 }
 
-MIB::Node* MIB::findNode(const char* oid) {
-    return const_cast<Node*>(const_cast<const MIB*>(this)->findNode(oid));
+MIB::Node* MIB::findNode(const uint8_t* oid, size_t length) {
+    return const_cast<Node*>(const_cast<const MIB*>(this)->findNode(oid, length));
 }
 
-bool MIB::addNode(const Node& node) {
-    if (node_count_ >= MAX_NODES) {
-        return false;
+size_t MIB::upperBound(const uint8_t* oid, size_t length) const {
+    size_t low = 0;
+    size_t high = node_count_;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (compareOID(nodes_[mid].oid, nodes_[mid].oidLength, oid, length) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+size_t MIB::upperBound(const uint8_t* oid, size_t length, size_t from) const {
+    // Gallop until nodes_[high] is after oid, then search [low, high)
+    size_t low = from;
+    size_t high = from;
+    size_t step = 1;
+    while (high < node_count_ &&
+           compareOID(nodes_[high].oid, nodes_[high].oidLength, oid, length) <= 0) {
+        low = high + 1;
+        high = low + step;
+        step *= 2;
+    }
+    if (high > node_count_) {
+        high = node_count_;
     }
     
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (compareOID(nodes_[mid].oid, nodes_[mid].oidLength, oid, length) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool MIB::addNode(const Node& node) {
     // Find insertion point to maintain sorted order
-    size_t pos = 0;
-    while (pos < node_count_ && compareOID(nodes_[pos].oid, node.oid) < 0) {
-        pos++;
+    size_t pos = upperBound(node.oid, node.oidLength);
+    
+    // Same OID: replace
+    if (pos > 0 && nodes_[pos - 1].oidLength == node.oidLength &&
+        memcmp(nodes_[pos - 1].oid, node.oid, node.oidLength) == 0) {
+        nodes_[pos - 1] = node;
+        markChanged();
+        return true;
+    }
+    
+    if (node_count_ >= MAX_NODES) {
+        return false;
     }
     
     // Shift existing nodes
@@ -279,6 +499,7 @@ bool MIB::addNode(const Node& node) {
     // Insert new node
     nodes_[pos] = node;
     node_count_++;
+    markChanged();
     return true;
 }
 
@@ -286,7 +507,8 @@ void MIB::sortNodes() {
     // Simple bubble sort since we don't expect too many nodes
     for (size_t i = 0; i < node_count_ - 1; i++) {
         for (size_t j = 0; j < node_count_ - i - 1; j++) {
-            if (compareOID(nodes_[j].oid, nodes_[j + 1].oid) > 0) {
+            if (compareOID(nodes_[j].oid, nodes_[j].oidLength,
+                           nodes_[j + 1].oid, nodes_[j + 1].oidLength) > 0) {
                 Node temp = nodes_[j];
                 nodes_[j] = nodes_[j + 1];
                 nodes_[j + 1] = temp;
@@ -0,0 +1,99 @@
+#include "OID.h"
+#include <string.h>
+#include <stdio.h>
+
+void invalidOIDLiteral() {
+    // Only reachable at runtime for non-constant literals; the OID is
+    // left invalid and callers check isValid().
+}
+
+bool OID::parse(const char* text, OID& oid) {
+    oid = OID();
+    if (!text || !oid.parseText(text, strlen(text))) {
+        oid = OID();
+        return false;
+    }
+    return true;
+}
+
+bool OID::fromComponents(const uint32_t* components, size_t count, OID& oid) {
+    oid = OID();
+    if (!components || count > MAX_COMPONENTS) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        oid.components_[i] = components[i];
+    }
+    oid.count_ = count;
+
+    if (!oid.encode()) {
+        oid = OID();
+        return false;
+    }
+    return true;
+}
+
+bool OID::fromEncoded(const uint8_t* encoded, size_t length, OID& oid) {
+    oid = OID();
+    if (!encoded || length == 0 || length > MAX_ENCODED_LENGTH) {
+        return false;
+    }
+
+    // Last octet must terminate a sub-identifier
+    if (encoded[length - 1] & 0x80) {
+        return false;
+    }
+
+    uint32_t value = 0;
+    for (size_t i = 0; i < length; i++) {
+        // Reject sub-identifiers that would overflow 32 bits
+        if (value > (0xFFFFFFFFu >> 7)) {
+            oid = OID();
+            return false;
+        }
+        value = (value << 7) | (encoded[i] & 0x7F);
+        if (encoded[i] & 0x80) {
+            continue;
+        }
+
+        if (oid.count_ == 0) {
+            // First sub-identifier packs the first two arcs
+            oid.components_[0] = (value < 80) ? value / 40 : 2;
+            oid.components_[1] = (value < 80) ? value % 40 : value - 80;
+            oid.count_ = 2;
+        } else if (!oid.append(value)) {
+            oid = OID();
+            return false;
+        }
+        value = 0;
+    }
+
+    memcpy(oid.encoded_, encoded, length);
+    oid.encodedLength_ = length;
+    return true;
+}
+
+bool OID::toString(char* buffer, size_t maxLength) const {
+    if (!buffer || maxLength == 0 || !isValid()) {
+        return false;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count_; i++) {
+        int written = snprintf(buffer + offset, maxLength - offset, i ? ".%lu" : "%lu",
+                               static_cast<unsigned long>(components_[i]));
+        if (written < 0 || offset + written >= maxLength) {
+            buffer[0] = '\0';
+            return false;
+        }
+        offset += written;
+    }
+
+    return true;
+}
+
+bool OID::operator==(const OID& other) const {
+    return encodedLength_ == other.encodedLength_ &&
+           memcmp(encoded_, other.encoded_, encodedLength_) == 0;
+}
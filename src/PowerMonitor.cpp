@@ -2,7 +2,16 @@
 #include "InterruptHandler.h"
 #include <Arduino.h>
 
-PowerMonitor::PowerMonitor(MIB& mib) : mib_(mib), lastInterruptTime_(0) {
+PowerMonitor* PowerMonitor::instance_ = nullptr;
+
+PowerMonitor::PowerMonitor(MIB& mib, TrapEmitter& traps)
+    : mib_(mib)
+    , traps_(traps)
+    , lastInterruptTime_(0)
+    , powerState_(POWER_STATE_ON)
+    , lastPowerLoss_(0)
+    , powerLossCount_(0) {
+    instance_ = this;
     initializeMIBNodes();
 }
 
@@ -11,21 +20,21 @@ void PowerMonitor::initializeMIBNodes() {
     mib_.registerNode(POWER_STATE_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
         []() {
             ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(POWER_STATE_ON);
+            value.setInteger(instance_->powerState_);
             return value;
         });
     
-    mib_.registerNode(LAST_POWER_LOSS_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+    mib_.registerNode(LAST_POWER_LOSS_OID, MIB::NodeType::TIMETICKS, MIB::Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(0);
+            ASN1Object value(ASN1Object::Type::TIMETICKS);
+            value.setTimeTicks(instance_->lastPowerLoss_);
             return value;
         });
     
-    mib_.registerNode(POWER_LOSS_COUNT_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+    mib_.registerNode(POWER_LOSS_COUNT_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(0);
+            ASN1Object value(ASN1Object::Type::COUNTER32);
+            value.setCounter32(instance_->powerLossCount_);
             return value;
         });
 }
@@ -60,25 +69,20 @@ void PowerMonitor::handleInterrupt() {
     // Read current power state
     bool powerPresent = (digitalRead(POWER_PIN) == HIGH);
     
-    // Update power state in MIB
-    ASN1Object stateValue(ASN1Object::Type::INTEGER);
-    stateValue.setInteger(powerPresent ? POWER_STATE_ON : POWER_STATE_OFF);
-    mib_.setValue(POWER_STATE_OID, stateValue);
-    
+    // The MIB nodes are read-only, so the state lives here
+    powerState_ = powerPresent ? POWER_STATE_ON : POWER_STATE_OFF;
     if (!powerPresent) {
-        // Update last power loss time
-        ASN1Object timeValue(ASN1Object::Type::INTEGER);
-        timeValue.setInteger(now);
-        mib_.setValue(LAST_POWER_LOSS_OID, timeValue);
-        
-        // Increment power loss count
-        ASN1Object countValue;
-        if (mib_.getValue(POWER_LOSS_COUNT_OID, countValue)) {
-            int32_t currentCount = countValue.getInteger();
-            countValue.setInteger(currentCount + 1);
-            mib_.setValue(POWER_LOSS_COUNT_OID, countValue);
-        }
+        lastPowerLoss_ = now / 10;      // Hundredths of a second
+        powerLossCount_ = powerLossCount_ + 1;     // Counter32 wraps at 2^32
     }
+    
+    // Cached responses may hold the old state
+    mib_.markChanged();
+    
+    // Managers hear about it now rather than at their next poll
+    uint32_t values[TrapEmitter::MAX_VALUES] = {powerState_, powerLossCount_};
+    traps_.raise(powerPresent ? TrapEmitter::Event::POWER_RESTORED : TrapEmitter::Event::POWER_LOST,
+                 now / 10, values);
 }
 
 bool PowerMonitor::isPowerPresent() const {
@@ -86,17 +90,9 @@ bool PowerMonitor::isPowerPresent() const {
 }
 
 uint32_t PowerMonitor::getPowerLossCount() const {
-    ASN1Object value;
-    if (mib_.getValue(POWER_LOSS_COUNT_OID, value)) {
-        return value.getInteger();
-    }
-    return 0;
+    return powerLossCount_;
 }
 
 uint32_t PowerMonitor::getLastPowerLossTime() const {
-    ASN1Object value;
-    if (mib_.getValue(LAST_POWER_LOSS_OID, value)) {
-        return value.getInteger();
-    }
-    return 0;
+    return lastPowerLoss_ * 10; // TimeTicks to milliseconds
 }
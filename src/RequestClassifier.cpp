@@ -0,0 +1,94 @@
+#include "RequestClassifier.h"
+#include "ASN1Types.h"
+#include "BERView.h"
+#include "SNMPMessage.h"
+
+using namespace ASN1;
+
+RequestClassifier::RequestClassifier() {
+    clear();
+}
+
+void RequestClassifier::clear() {
+    for (uint8_t i = 0; i < MAX_WALKERS; i++) {
+        walkers_[i].valid = false;
+    }
+}
+
+RequestClassifier::Priority RequestClassifier::classify(const uint8_t* packet, uint16_t size,
+                                                        uint32_t remoteIP, uint32_t now) {
+    if (!packet) {
+        return Priority::LOW;
+    }
+
+    BERReader reader(packet, size);
+    BERView message, field, pdu;
+    if (!reader.read(SEQUENCE_TAG, message)) {
+        return Priority::LOW;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, field) || !fields.read(OCTET_STRING_TAG, field) ||
+        !fields.read(pdu)) {
+        return Priority::LOW;
+    }
+
+    switch (static_cast<SNMPMessage::PDUType>(pdu.tag)) {
+        case SNMPMessage::PDUType::GET_RESPONSE:
+            return Priority::HIGH;
+        case SNMPMessage::PDUType::GET_BULK_REQUEST:
+            walk(remoteIP, now);
+            return Priority::LOW;
+        case SNMPMessage::PDUType::GET_NEXT_REQUEST:
+            return walk(remoteIP, now) ? Priority::LOW : Priority::NORMAL;
+        case SNMPMessage::PDUType::SET_REQUEST:
+            return Priority::NORMAL;
+        case SNMPMessage::PDUType::GET_REQUEST:
+            break;
+        default:
+            return Priority::LOW;
+    }
+
+    // Count GetRequest varbinds, stopping once past a probe's
+    BERReader pduFields(pdu);
+    BERView list;
+    if (!pduFields.read(INTEGER_TAG, field) || !pduFields.read(INTEGER_TAG, field) ||
+        !pduFields.read(INTEGER_TAG, field) || !pduFields.read(SEQUENCE_TAG, list)) {
+        return Priority::LOW;
+    }
+    BERReader entries(list);
+    uint8_t count = 0;
+    while (!entries.atEnd() && count <= PROBE_VARBINDS) {
+        if (!entries.read(SEQUENCE_TAG, field)) {
+            return Priority::LOW;
+        }
+        count++;
+    }
+    return count <= PROBE_VARBINDS ? Priority::HIGH : Priority::NORMAL;
+}
+
+bool RequestClassifier::walk(uint32_t remoteIP, uint32_t now) {
+    // The client's entry, else a free or the least recently seen one
+    Walker* slot = &walkers_[0];
+    for (uint8_t i = 0; i < MAX_WALKERS; i++) {
+        Walker& walker = walkers_[i];
+        if (!walker.valid) {
+            if (slot->valid) {
+                slot = &walker;
+            }
+            continue;
+        }
+        if (walker.remoteIP == remoteIP) {
+            bool walking = now - walker.lastSeen < WALK_WINDOW_MS;
+            walker.lastSeen = now;
+            return walking;
+        }
+        if (slot->valid && now - walker.lastSeen > now - slot->lastSeen) {
+            slot = &walker;
+        }
+    }
+
+    slot->valid = true;
+    slot->remoteIP = remoteIP;
+    slot->lastSeen = now;
+    return false;
+}
@@ -0,0 +1,194 @@
+#include "ResponseCache.h"
+#include "ASN1Types.h"
+#include "BERView.h"
+#include "BERWriter.h"
+#include "Hash.h"
+#include "SNMPMessage.h"
+#include <string.h>
+
+using namespace ASN1;
+
+namespace {
+    bool isCacheable(uint8_t pduTag) {
+        return pduTag == static_cast<uint8_t>(SNMPMessage::PDUType::GET_REQUEST) ||
+               pduTag == static_cast<uint8_t>(SNMPMessage::PDUType::GET_NEXT_REQUEST) ||
+               pduTag == static_cast<uint8_t>(SNMPMessage::PDUType::GET_BULK_REQUEST);
+    }
+
+    bool append(ResponseCache::Key& key, const uint8_t* data, size_t length) {
+        if (key.length + length > ResponseCache::MAX_KEY_SIZE) {
+            return false;
+        }
+        memcpy(key.bytes + key.length, data, length);
+        key.length += length;
+        return true;
+    }
+}
+
+ResponseCache::ResponseCache(uint32_t ttlMs)
+    : ttlMs_(ttlMs)
+    , tick_(0)
+    , hits_(0)
+    , misses_(0)
+{
+    clear();
+}
+
+void ResponseCache::clear() {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        entries_[i].valid = false;
+    }
+}
+
+bool ResponseCache::makeKey(const uint8_t* request, uint16_t size, Key& key) {
+    if (!request) {
+        return false;
+    }
+
+    BERReader packet(request, size);
+    BERView message, version, community, pdu;
+    BERView requestID, errorStatus, errorIndex, list;
+    if (!packet.read(SEQUENCE_TAG, message)) {
+        return false;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, version) ||
+        !fields.read(OCTET_STRING_TAG, community) ||
+        community.length >= SNMPMessage::MAX_COMMUNITY_LENGTH ||
+        !fields.read(pdu) || !isCacheable(pdu.tag)) {
+        return false;
+    }
+    BERReader pduFields(pdu);
+    if (!pduFields.read(INTEGER_TAG, requestID) || !requestID.getInteger(key.requestID) ||
+        !pduFields.read(INTEGER_TAG, errorStatus) ||
+        !pduFields.read(INTEGER_TAG, errorIndex) ||
+        !pduFields.read(SEQUENCE_TAG, list)) {
+        return false;
+    }
+
+    // Version and community TLVs, which the response repeats
+    const uint8_t* pduStart = community.data + community.length;
+    const uint8_t* errorStart = requestID.data + requestID.length;
+    const uint8_t* errorEnd = errorIndex.data + errorIndex.length;
+    key.length = 0;
+    if (!append(key, message.data, pduStart - message.data)) {
+        return false;
+    }
+    key.prefixLength = key.length;
+
+    // Everything else that decides the response, except the request-id
+    if (!append(key, &pdu.tag, 1) || !append(key, errorStart, errorEnd - errorStart)) {
+        return false;
+    }
+    BERReader entries(list);
+    while (!entries.atEnd()) {
+        BERView entry, oid;
+        if (!entries.read(SEQUENCE_TAG, entry)) {
+            return false;
+        }
+        BERReader entryFields(entry);
+        if (!entryFields.read(OBJECT_IDENTIFIER_TAG, oid) ||
+            !append(key, entry.data, oid.data + oid.length - entry.data)) {
+            return false;
+        }
+    }
+
+    key.hash = fnv1a(key.bytes, key.length);
+    return true;
+}
+
+ResponseCache::Entry* ResponseCache::find(const Key& key) {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        Entry& entry = entries_[i];
+        if (entry.valid && entry.hash == key.hash && entry.keyLength == key.length &&
+            memcmp(entry.key, key.bytes, key.length) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+uint16_t ResponseCache::lookup(const Key& key, uint32_t generation, uint32_t now,
+                               uint8_t* buffer, uint16_t capacity, const uint8_t*& response) {
+    Entry* entry = find(key);
+    if (entry && (entry->generation != generation || now - entry->storedAt >= ttlMs_)) {
+        entry->valid = false;       // Stale
+        entry = nullptr;
+    }
+    if (!entry) {
+        misses_++;
+        return 0;
+    }
+
+    // Cached body, then the header of this request
+    BERWriter writer(buffer, capacity);
+    writer.writeBytes(entry->body, entry->bodyLength);
+    writer.writeInteger(INTEGER_TAG, key.requestID);
+    writer.endConstructed(static_cast<uint8_t>(SNMPMessage::PDUType::GET_RESPONSE), 0);
+    writer.writeBytes(key.bytes, key.prefixLength);
+    writer.endConstructed(SEQUENCE_TAG, 0);
+    if (!writer.ok() || writer.size() > SNMPMessage::MAX_PACKET_SIZE) {
+        misses_++;
+        return 0;
+    }
+
+    entry->lastUsed = ++tick_;
+    hits_++;
+    response = writer.data();
+    return writer.size();
+}
+
+bool ResponseCache::store(const Key& key, uint32_t generation, uint32_t now,
+                          const uint8_t* response, uint16_t size) {
+    if (!response) {
+        return false;
+    }
+
+    // The body is the PDU content after the request-id
+    BERReader packet(response, size);
+    BERView message, field, pdu, requestID;
+    if (!packet.read(SEQUENCE_TAG, message)) {
+        return false;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, field) || !fields.read(OCTET_STRING_TAG, field) ||
+        !fields.read(static_cast<uint8_t>(SNMPMessage::PDUType::GET_RESPONSE), pdu)) {
+        return false;
+    }
+    BERReader pduFields(pdu);
+    if (!pduFields.read(INTEGER_TAG, requestID)) {
+        return false;
+    }
+    const uint8_t* body = requestID.data + requestID.length;
+    size_t bodyLength = pdu.data + pdu.length - body;
+    if (bodyLength > MAX_BODY_SIZE) {
+        return false;
+    }
+
+    // Same key, a free slot, or the least recently used
+    Entry* entry = find(key);
+    for (uint8_t i = 0; !entry && i < CAPACITY; i++) {
+        if (!entries_[i].valid) {
+            entry = &entries_[i];
+        }
+    }
+    if (!entry) {
+        entry = &entries_[0];
+        for (uint8_t i = 1; i < CAPACITY; i++) {
+            if (entries_[i].lastUsed < entry->lastUsed) {
+                entry = &entries_[i];
+            }
+        }
+    }
+
+    entry->valid = true;
+    entry->hash = key.hash;
+    entry->generation = generation;
+    entry->storedAt = now;
+    entry->lastUsed = ++tick_;
+    entry->keyLength = key.length;
+    entry->bodyLength = bodyLength;
+    memcpy(entry->key, key.bytes, key.length);
+    memcpy(entry->body, body, bodyLength);
+    return true;
+}
@@ -0,0 +1,112 @@
+#include "RetransmitCache.h"
+#include "ASN1Types.h"
+#include "BERView.h"
+#include "Hash.h"
+#include <string.h>
+
+using namespace ASN1;
+
+RetransmitCache::RetransmitCache(uint32_t windowMs)
+    : sequence_(0)
+    , windowMs_(windowMs)
+    , duplicates_(0)
+{
+    clear();
+}
+
+void RetransmitCache::clear() {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        entries_[i].valid = false;
+    }
+}
+
+bool RetransmitCache::makeKey(const uint8_t* request, uint16_t size,
+                              uint32_t remoteIP, uint16_t remotePort, Key& key) {
+    if (!request) {
+        return false;
+    }
+
+    // Only as far as the request-id; any PDU type
+    BERReader packet(request, size);
+    BERView message, field, pdu, requestID;
+    if (!packet.read(SEQUENCE_TAG, message)) {
+        return false;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, field) || !fields.read(OCTET_STRING_TAG, field) ||
+        !fields.read(pdu)) {
+        return false;
+    }
+    BERReader pduFields(pdu);
+    if (!pduFields.read(INTEGER_TAG, requestID) || !requestID.getInteger(key.requestID)) {
+        return false;
+    }
+
+    key.remoteIP = remoteIP;
+    key.remotePort = remotePort;
+    key.hash = fnv1a(request, size);
+    return true;
+}
+
+const uint8_t* RetransmitCache::find(const Key& key, uint32_t now, uint16_t& size) {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        Entry& entry = entries_[i];
+        if (!entry.valid || entry.key.requestID != key.requestID ||
+            entry.key.remoteIP != key.remoteIP || entry.key.remotePort != key.remotePort ||
+            entry.key.hash != key.hash) {
+            continue;
+        }
+        if (now - entry.storedAt >= windowMs_) {
+            entry.valid = false;        // A new request that reuses the id
+            return nullptr;
+        }
+        duplicates_++;
+        size = entry.size;
+        return entry.response;
+    }
+    return nullptr;
+}
+
+void RetransmitCache::store(const Key& key, uint32_t now, const uint8_t* response, uint16_t size) {
+    if (!response || size == 0 || size > MAX_RESPONSE_SIZE) {
+        return;
+    }
+
+    Entry& entry = slotFor(key, now);
+    entry.valid = true;
+    entry.key = key;
+    entry.storedAt = now;
+    entry.sequence = ++sequence_;
+    entry.size = size;
+    memcpy(entry.response, response, size);
+}
+
+bool RetransmitCache::isLive(const Entry& entry, uint32_t now) const {
+    return entry.valid && now - entry.storedAt < windowMs_;
+}
+
+RetransmitCache::Entry& RetransmitCache::slotFor(const Key& key, uint32_t now) {
+    Entry* clientOldest = nullptr;
+    Entry* victim = nullptr;
+    uint8_t held = 0;
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        Entry& entry = entries_[i];
+        if (!isLive(entry, now)) {
+            if (!victim || isLive(*victim, now)) {
+                victim = &entry;        // Free, or no longer used by find()
+            }
+            continue;
+        }
+        if (entry.key.remoteIP == key.remoteIP && entry.key.remotePort == key.remotePort) {
+            held++;
+            if (!clientOldest || static_cast<int32_t>(entry.sequence - clientOldest->sequence) < 0) {
+                clientOldest = &entry;
+            }
+        }
+        if (!victim || (isLive(*victim, now) &&
+                        static_cast<int32_t>(entry.sequence - victim->sequence) < 0)) {
+            victim = &entry;
+        }
+    }
+    return held >= MAX_PER_CLIENT ? *clientOldest : *victim;
+}
@@ -0,0 +1,194 @@
+#include "SNMPBulkResponder.h"
+#include "ASN1Types.h"
+#include "BERKernels.h"
+#include "BERWriter.h"
+#include <string.h>
+
+using namespace ASN1;
+
+namespace {
+    constexpr uint8_t TOO_BIG = 1;
+    constexpr uint8_t GEN_ERR = 5;
+
+    // error-status and error-index are both below 128
+    constexpr uint32_t ERROR_FIELDS_SIZE = 6;
+}
+
+uint16_t SNMPBulkResponder::respond(const SNMPMessage& request, MIB& mib,
+                                    uint8_t* buffer, uint16_t capacity,
+                                    const uint8_t*& response) {
+    if (!buffer || request.getPDUType() != SNMPMessage::PDUType::GET_BULK_REQUEST ||
+        request.getVersion() != SNMPMessage::VERSION_2C) {
+        return 0;
+    }
+
+    // Copy what the response needs from the request, which the output
+    // may overwrite
+    uint8_t version = request.getVersion();
+    uint32_t requestID = request.getRequestID();
+    char community[SNMPMessage::MAX_COMMUNITY_LENGTH];
+    size_t communityLength = request.getCommunityLength();
+    memcpy(community, request.getCommunity(), communityLength);
+
+    const SNMPMessage::VarBindView* views = request.getVarBindViews();
+    size_t count = request.getVarBindViewCount();
+    size_t nonRepeaters = request.getNonRepeaters() > 0 ? request.getNonRepeaters() : 0;
+    if (nonRepeaters > count) {
+        nonRepeaters = count;
+    }
+    int32_t maxRepetitions = request.getMaxRepetitions();
+
+    // First lexicographic successors; afterwards cursors point into the
+    // MIB. Without room for them, or for every request varbind, the
+    // request is answered tooBig.
+    Cursor* cursors = request.isTruncated() ? nullptr : request.getArena().allocate<Cursor>(count);
+    for (size_t i = 0; cursors && i < count; i++) {
+        if (!start(views[i].oid.data, views[i].oid.length, mib, cursors[i])) {
+            return 0;
+        }
+    }
+
+    Output output;
+    output.buffer = buffer;
+    output.capacity = capacity;
+    output.used = 0;
+    output.messageFields = BERKernel::tlvSize(BERKernel::integerSize(static_cast<int32_t>(version))) +
+                           BERKernel::tlvSize(communityLength);
+    output.pduFields = BERKernel::tlvSize(BERKernel::integerSize(static_cast<int32_t>(requestID))) +
+                       ERROR_FIELDS_SIZE;
+
+    // Room for the largest header the budget allows
+    uint32_t headerSize = messageSize(output, SNMPMessage::MAX_PACKET_SIZE) - SNMPMessage::MAX_PACKET_SIZE;
+    if (headerSize >= capacity) {
+        return 0;
+    }
+    output.start = headerSize;
+
+    // Non-repeaters once, then up to max-repetitions rows of repeaters
+    uint8_t status = cursors ? 0 : TOO_BIG;
+    size_t i = 0;
+    while (cursors && i < nonRepeaters && append(mib, cursors[i], output, status)) {
+        i++;
+    }
+    bool more = cursors && i == nonRepeaters && nonRepeaters < count;
+    for (int32_t row = 0; more && row < maxRepetitions; row++) {
+        bool allEnd = true;
+        for (i = nonRepeaters; i < count; i++) {
+            allEnd = allEnd && cursors[i].end;
+            if (!append(mib, cursors[i], output, status)) {
+                more = false;
+                break;
+            }
+            if (row + 1 < maxRepetitions) {
+                advance(mib, cursors[i]);
+            }
+        }
+        if (allEnd) {
+            break;
+        }
+    }
+
+    uint32_t errorIndex = 0;
+    if (status == GEN_ERR) {
+        output.used = 0;
+        errorIndex = i + 1;
+    }
+
+    // Header back to front, ending at the first varbind
+    BERWriter writer(buffer, output.start);
+    writer.writeHeader(SEQUENCE_TAG, output.used);
+    writer.writeInteger(INTEGER_TAG, errorIndex);
+    writer.writeInteger(INTEGER_TAG, status);
+    writer.writeInteger(INTEGER_TAG, requestID);
+    writer.writeHeader(static_cast<uint8_t>(SNMPMessage::PDUType::GET_RESPONSE),
+                       writer.size() + output.used);
+    writer.writeOctetString(OCTET_STRING_TAG, reinterpret_cast<const uint8_t*>(community),
+                            communityLength);
+    writer.writeInteger(INTEGER_TAG, version);
+    writer.writeHeader(SEQUENCE_TAG, writer.size() + output.used);
+    if (!writer.ok()) {
+        return 0;
+    }
+
+    response = writer.data();
+    return writer.size() + output.used;
+}
+
+bool SNMPBulkResponder::start(const uint8_t* oid, size_t length, MIB& mib, Cursor& cursor) {
+    size_t nextLength;
+    if (mib.getNextOID(oid, length, cursor.oid, nextLength)) {
+        cursor.oidLength = nextLength;
+        cursor.end = false;
+        return true;
+    }
+
+    // endOfMibView answers with the request's own name
+    if (length == 0 || length > OID::MAX_ENCODED_LENGTH) {
+        return false;
+    }
+    memcpy(cursor.copy, oid, length);
+    cursor.oid = cursor.copy;
+    cursor.oidLength = length;
+    cursor.end = true;
+    return true;
+}
+
+void SNMPBulkResponder::advance(MIB& mib, Cursor& cursor) {
+    if (cursor.end) {
+        return;
+    }
+    const uint8_t* next;
+    size_t nextLength;
+    if (mib.getNextOID(cursor.oid, cursor.oidLength, next, nextLength)) {
+        cursor.oid = next;
+        cursor.oidLength = nextLength;
+    } else {
+        cursor.end = true;      // Keeps the last name
+    }
+}
+
+bool SNMPBulkResponder::append(MIB& mib, const Cursor& cursor, Output& output, uint8_t& status) {
+    ASN1Object value;
+    const uint8_t* encoded = nullptr;
+    uint16_t encodedSize = 0;
+    uint32_t valueSize = BERKernel::tlvSize(0);
+    if (!cursor.end && mib.getEncodedValue(cursor.oid, cursor.oidLength, encoded, encodedSize)) {
+        valueSize = encodedSize;
+    } else if (!cursor.end) {
+        if (!mib.getValue(cursor.oid, cursor.oidLength, value) ||
+            (valueSize = value.encodedSize()) == 0) {
+            status = GEN_ERR;
+            return false;
+        }
+    }
+
+    uint32_t size = BERKernel::tlvSize(BERKernel::tlvSize(cursor.oidLength) + valueSize);
+    if (messageSize(output, output.used + size) > SNMPMessage::MAX_PACKET_SIZE ||
+        output.start + output.used + size > output.capacity) {
+        return false;       // Budget reached; what fits is sent
+    }
+
+    // Each varbind is encoded back to front into its exact slot
+    BERWriter writer(output.buffer + output.start + output.used, size);
+    if (cursor.end) {
+        writer.writeHeader(END_OF_MIB_VIEW_TAG, 0);
+    } else if (encoded) {
+        writer.writeBytes(encoded, encodedSize);
+    } else {
+        value.encode(writer);
+    }
+    writer.writeOctetString(OBJECT_IDENTIFIER_TAG, cursor.oid, cursor.oidLength);
+    writer.endConstructed(SEQUENCE_TAG, 0);
+    if (!writer.ok()) {
+        status = GEN_ERR;
+        return false;
+    }
+
+    output.used += size;
+    return true;
+}
+
+uint32_t SNMPBulkResponder::messageSize(const Output& output, uint32_t varBindBytes) {
+    uint32_t pdu = BERKernel::tlvSize(output.pduFields + BERKernel::tlvSize(varBindBytes));
+    return BERKernel::tlvSize(output.messageFields + pdu);
+}
@@ -1,76 +1,152 @@
 #include "SNMPMessage.h"
 #include "ASN1Object.h"
+#include "ASN1Types.h"
+#include "BERKernels.h"
+#include "BERView.h"
+#include "BERWriter.h"
 #include "ErrorHandler.h"
+#include "SNMPSchema.h"
+#include "SNMPStreamDecoder.h"
 #include <string.h>
-#include <stdio.h>
 
-bool SNMPMessage::numericToStringOID(const uint32_t* numericOID, size_t length, char* stringOID, size_t maxLength) {
-    if (!numericOID || !stringOID || !length || !maxLength) {
-        return false;
-    }
-    
-    size_t offset = 0;
-    offset += snprintf(stringOID + offset, maxLength - offset, "%lu", (unsigned long)numericOID[0]);
-    
-    for (size_t i = 1; i < length && offset < maxLength; i++) {
-        offset += snprintf(stringOID + offset, maxLength - offset, ".%lu", (unsigned long)numericOID[i]);
-    }
-    
-    return offset < maxLength;
-}
-
-bool SNMPMessage::stringToNumericOID(const char* stringOID, uint32_t* numericOID, size_t* length, size_t maxLength) {
-    if (!stringOID || !numericOID || !length || !maxLength) {
-        return false;
+namespace {
+    Arena& sharedArena() {
+        alignas(8) static uint8_t storage[SNMPMessage::SHARED_ARENA_SIZE];
+        static Arena arena(storage, sizeof(storage));
+        return arena;
     }
     
-    *length = 0;
-    const char* ptr = stringOID;
+    // Live messages on the shared arena
+    size_t sharedUsers = 0;
     
-    while (*ptr && *length < maxLength) {
-        // Skip dots
-        if (*ptr == '.') {
-            ptr++;
-            continue;
+    // Room for count items, doubling so one-at-a-time appends stay cheap
+    template <typename T>
+    bool reserve(Arena& arena, T*& items, size_t& capacity, size_t count) {
+        if (count <= capacity) {
+            return true;
         }
-        
-        // Parse number
-        char* end;
-        unsigned long num = strtoul(ptr, &end, 10);
-        if (end == ptr) {
+        size_t wanted = capacity * 2 > count ? capacity * 2 : count;
+        T* grown = arena.grow(items, capacity, wanted);
+        if (!grown && wanted > count) {
+            wanted = count;
+            grown = arena.grow(items, capacity, wanted);
+        }
+        if (!grown) {
             return false;
         }
-        
-        numericOID[(*length)++] = num;
-        ptr = end;
+        items = grown;
+        capacity = wanted;
+        return true;
     }
-    
-    return true;
 }
 
 SNMPMessage::SNMPMessage()
+    : SNMPMessage(sharedArena())
+{
+    sharedArena_ = true;
+    sharedUsers++;
+}
+
+SNMPMessage::SNMPMessage(Arena& arena)
     : version_(0)
     , pduType_(PDUType::GET_REQUEST)
     , requestID_(0)
     , errorStatus_(0)
     , errorIndex_(0)
+    , arena_(&arena)
+    , sharedArena_(false)
+    , varBinds_(nullptr)
     , varBind_count_(0)
+    , varBind_capacity_(0)
+    , varBindViews_(nullptr)
+    , varBindView_count_(0)
+    , varBindView_capacity_(0)
+    , truncated_(false)
+    , spillUsed_(0)
 {
     community_[0] = '\0';
 }
 
+SNMPMessage::~SNMPMessage() {
+    if (sharedArena_ && --sharedUsers == 0) {
+        arena_->reset();
+    }
+}
+
+void SNMPMessage::clear() {
+    version_ = 0;
+    community_[0] = '\0';
+    pduType_ = PDUType::GET_REQUEST;
+    requestID_ = 0;
+    errorStatus_ = 0;
+    errorIndex_ = 0;
+    communityView_ = BERView();
+    varBinds_ = nullptr;
+    varBind_count_ = 0;
+    varBind_capacity_ = 0;
+    varBindViews_ = nullptr;
+    varBindView_count_ = 0;
+    varBindView_capacity_ = 0;
+    truncated_ = false;
+    spillUsed_ = 0;
+}
+
+bool SNMPMessage::reserveVarBinds(size_t count) {
+    return reserve(*arena_, varBinds_, varBind_capacity_, count);
+}
+
+bool SNMPMessage::reserveVarBindViews(size_t count) {
+    return reserve(*arena_, varBindViews_, varBindView_capacity_, count);
+}
+
+void SNMPMessage::trimVarBindViews() {
+    arena_->shrink(varBindViews_, varBindView_capacity_, varBindView_count_);
+    varBindView_capacity_ = varBindView_count_;
+}
+
+const char* SNMPMessage::getCommunity() const {
+    if (communityView_.isValid()) {
+        return reinterpret_cast<const char*>(communityView_.data);
+    }
+    return community_;
+}
+
+size_t SNMPMessage::getCommunityLength() const {
+    if (communityView_.isValid()) {
+        return communityView_.length;
+    }
+    return strlen(community_);
+}
+
 void SNMPMessage::setCommunity(const char* community) {
-    strncpy(community_, community, MAX_COMMUNITY_LENGTH - 1);
-    community_[MAX_COMMUNITY_LENGTH - 1] = '\0';
+    setCommunity(community, strlen(community));
+}
+
+void SNMPMessage::setCommunity(const char* community, size_t length) {
+    size_t copyLength = (length < MAX_COMMUNITY_LENGTH) ? length : MAX_COMMUNITY_LENGTH - 1;
+    memcpy(community_, community, copyLength);
+    community_[copyLength] = '\0';
+    communityView_ = BERView();
+}
+
+bool SNMPMessage::addVarBind(const OID& oid, const ASN1Object& value) {
+    return oid.isValid() && addVarBind(oid.getEncoded(), oid.getEncodedLength(), value);
 }
 
-bool SNMPMessage::addVarBind(const char* oid, const ASN1Object& value) {
-    if (varBind_count_ >= MAX_VARBINDS) {
+bool SNMPMessage::addVarBind(const uint8_t* oid, size_t oidLength, const ASN1Object& value) {
+    if (!oid || oidLength == 0 || oidLength > OID::MAX_ENCODED_LENGTH ||
+        !reserveVarBinds(varBind_count_ + 1)) {
         return false;
     }
     
-    strncpy(varBinds_[varBind_count_].oid, oid, MAX_OID_STRING_LENGTH - 1);
-    varBinds_[varBind_count_].oid[MAX_OID_STRING_LENGTH - 1] = '\0';
+    // The source may be the receive buffer the response is encoded over
+    uint8_t* copy = arena_->allocate<uint8_t>(oidLength);
+    if (!copy) {
+        return false;
+    }
+    memcpy(copy, oid, oidLength);
+    varBinds_[varBind_count_].oid = copy;
+    varBinds_[varBind_count_].oidLength = oidLength;
     varBinds_[varBind_count_].value = value;
     varBind_count_++;
     
@@ -86,230 +162,122 @@ bool SNMPMessage::decode(const uint8_t* buffer, uint16_t size) {
         return false;
     }
     
-    uint16_t offset = 0;
-    varBind_count_ = 0;
-    
-    // Decode SNMP message sequence
-    ASN1Object sequence;
-    if (!sequence.decode(buffer, size, offset)) {
-        REPORT_ERROR(ErrorHandler::Severity::WARNING,
-                    ErrorHandler::Category::PROTOCOL,
-                    0x4003,
-                    "Failed to decode SNMP sequence");
-        return false;
-    }
-    
-    // Decode version
-    ASN1Object versionObj;
-    if (!versionObj.decode(buffer, size, offset)) {
-        REPORT_ERROR(ErrorHandler::Severity::WARNING,
-                    ErrorHandler::Category::PROTOCOL,
-                    0x4004,
-                    "Failed to decode SNMP version");
-        return false;
-    }
-    version_ = versionObj.getInteger();
-    
-    // Decode community string
-    ASN1Object communityObj;
-    if (!communityObj.decode(buffer, size, offset)) {
-        REPORT_ERROR(ErrorHandler::Severity::WARNING,
-                    ErrorHandler::Category::PROTOCOL,
-                    0x4005,
-                    "Failed to decode community string");
-        return false;
-    }
-    setCommunity(communityObj.getString());
-    
-    // Decode PDU
-    return decodePDU(buffer, size, offset);
+    // Same decoder as the chunked path, fed the whole datagram at once
+    SNMPStreamDecoder decoder(*this);
+    decoder.begin();
+    decoder.feed(buffer, size);
+    return decoder.finish();
 }
 
-bool SNMPMessage::decodePDU(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    // Get PDU type
-    if (offset >= size) {
-        return false;
-    }
-    pduType_ = static_cast<PDUType>(buffer[offset]);
-    
-    // Decode PDU sequence
-    ASN1Object pduSequence;
-    if (!pduSequence.decode(buffer, size, offset)) {
+bool SNMPMessage::readCommunity(const uint8_t* buffer, uint16_t size,
+                                const char*& community, size_t& length) {
+    if (!buffer) {
         return false;
     }
     
-    // Decode request ID
-    ASN1Object requestIDObj;
-    if (!requestIDObj.decode(buffer, size, offset)) {
+    // Message SEQUENCE, version, community; the PDU is not looked at
+    BERReader packet(buffer, size);
+    BERView message, version, field;
+    if (!packet.read(ASN1::SEQUENCE_TAG, message)) {
         return false;
     }
-    requestID_ = requestIDObj.getInteger();
-    
-    // Decode error status
-    ASN1Object errorStatusObj;
-    if (!errorStatusObj.decode(buffer, size, offset)) {
-        return false;
-    }
-    errorStatus_ = errorStatusObj.getInteger();
-    
-    // Decode error index
-    ASN1Object errorIndexObj;
-    if (!errorIndexObj.decode(buffer, size, offset)) {
+    BERReader fields(message);
+    if (!fields.read(ASN1::INTEGER_TAG, version) || !fields.read(ASN1::OCTET_STRING_TAG, field)) {
         return false;
     }
-    errorIndex_ = errorIndexObj.getInteger();
-    
-    // Decode variable bindings
-    return decodeVarBinds(buffer, size, offset);
+    community = reinterpret_cast<const char*>(field.data);
+    length = field.length;
+    return true;
 }
 
-bool SNMPMessage::decodeVarBinds(const uint8_t* buffer, uint16_t size, uint16_t& offset) {
-    // Decode varbind sequence
-    ASN1Object varbindSequence;
-    if (!varbindSequence.decode(buffer, size, offset)) {
+bool SNMPMessage::decode(const uint8_t* first, uint16_t firstSize,
+                         const uint8_t* second, uint16_t secondSize) {
+    if (!first || firstSize + secondSize < 2) {
+        REPORT_ERROR(ErrorHandler::Severity::WARNING,
+                    ErrorHandler::Category::PROTOCOL,
+                    0x4002,
+                    "Invalid SNMP message buffer");
         return false;
     }
     
-    // Reset varbind count
-    varBind_count_ = 0;
-    
-    // Decode each varbind
-    while (offset < size && varBind_count_ < MAX_VARBINDS) {
-        // Decode varbind sequence
-        ASN1Object varbindObj;
-        if (!varbindObj.decode(buffer, size, offset)) {
-            break;
-        }
-        
-        // Decode OID
-        ASN1Object oidObj;
-        if (!oidObj.decode(buffer, size, offset)) {
-            return false;
-        }
-        
-        // Decode value
-        ASN1Object valueObj;
-        if (!valueObj.decode(buffer, size, offset)) {
-            return false;
-        }
-        
-        // Convert numeric OID to string and add to varbind list
-        if (!numericToStringOID(oidObj.getOID(), oidObj.getOIDLength(),
-                              varBinds_[varBind_count_].oid, MAX_OID_STRING_LENGTH)) {
-            return false;
-        }
-        
-        varBinds_[varBind_count_].value = valueObj;
-        varBind_count_++;
+    SNMPStreamDecoder decoder(*this);
+    decoder.begin();
+    if (decoder.feed(first, firstSize) && secondSize > 0) {
+        decoder.feed(second, secondSize);
     }
-    
-    return true;
+    return decoder.finish();
 }
 
-uint16_t SNMPMessage::encode(uint8_t* buffer, uint16_t maxSize) {
+uint16_t SNMPMessage::encode(uint8_t* buffer, uint16_t maxSize) const {
     if (!buffer || maxSize < 2) {
         return 0;
     }
     
-    uint16_t offset = 0;
-    
-    // Start SNMP sequence
-    buffer[offset++] = 0x30; // Sequence tag
-    uint16_t lengthOffset = offset++;
-    
-    // Encode version
-    ASN1Object versionObj(ASN1Object::Type::INTEGER);
-    versionObj.setInteger(version_);
-    offset += versionObj.encode(buffer + offset, maxSize - offset);
-    
-    // Encode community string
-    ASN1Object communityObj(ASN1Object::Type::OCTET_STRING);
-    communityObj.setString(community_, strlen(community_));
-    offset += communityObj.encode(buffer + offset, maxSize - offset);
-    
-    // Encode PDU
-    offset += encodePDU(buffer + offset, maxSize - offset);
-    
-    // Update sequence length
-    buffer[lengthOffset] = offset - 2;
+    BERWriter writer(buffer, maxSize);
+    if (!encode(writer)) {
+        return 0;
+    }
     
-    return offset;
+    // The writer fills the tail of the buffer; callers of this overload
+    // expect the message at the start, so move the finished packet once.
+    uint16_t length = writer.size();
+    memmove(buffer, writer.data(), length);
+    return length;
 }
 
-uint16_t SNMPMessage::encodePDU(uint8_t* buffer, uint16_t maxSize) {
-    if (!buffer || maxSize < 2) {
-        return 0;
+uint16_t SNMPMessage::encodedSize() const {
+    uint32_t varBindBytes = 0;
+    for (size_t i = 0; i < varBind_count_; i++) {
+        uint16_t size = varBindSize(varBinds_[i].oidLength, varBinds_[i].value);
+        if (size == 0) {
+            return 0;
+        }
+        varBindBytes += size;
     }
     
-    uint16_t offset = 0;
-    
-    // Write PDU type
-    buffer[offset++] = static_cast<uint8_t>(pduType_);
-    uint16_t lengthOffset = offset++;
-    
-    // Encode request ID
-    ASN1Object requestIDObj(ASN1Object::Type::INTEGER);
-    requestIDObj.setInteger(requestID_);
-    offset += requestIDObj.encode(buffer + offset, maxSize - offset);
-    
-    // Encode error status
-    ASN1Object errorStatusObj(ASN1Object::Type::INTEGER);
-    errorStatusObj.setInteger(errorStatus_);
-    offset += errorStatusObj.encode(buffer + offset, maxSize - offset);
-    
-    // Encode error index
-    ASN1Object errorIndexObj(ASN1Object::Type::INTEGER);
-    errorIndexObj.setInteger(errorIndex_);
-    offset += errorIndexObj.encode(buffer + offset, maxSize - offset);
-    
-    // Encode variable bindings
-    offset += encodeVarBinds(buffer + offset, maxSize - offset);
-    
-    // Update PDU length
-    buffer[lengthOffset] = offset - 2;
-    
-    return offset;
+    uint32_t total = sizeWithVarBinds(varBindBytes);
+    return (total <= UINT16_MAX) ? total : 0;
 }
 
-uint16_t SNMPMessage::encodeVarBinds(uint8_t* buffer, uint16_t maxSize) {
-    if (!buffer || maxSize < 2) {
+uint16_t SNMPMessage::varBindSize(size_t oidContentLength, const ASN1Object& value) {
+    uint16_t valueSize = value.encodedSize();
+    if (valueSize == 0 || oidContentLength == 0) {
         return 0;
     }
+    return BERKernel::tlvSize(BERKernel::tlvSize(oidContentLength) + valueSize);
+}
+
+uint32_t SNMPMessage::sizeWithVarBinds(uint32_t varBindBytes) const {
+    return SNMPSchema::Message::size(*this, varBindBytes);
+}
+
+bool SNMPMessage::encode(BERWriter& writer) const {
+    // Fields are written last to first, as laid out in SNMPSchema
+    return SNMPSchema::Message::encode(writer, *this) && writer.ok();
+}
+
+bool SNMPMessage::encodeVarBinds(BERWriter& writer) const {
+    uint16_t listMark = writer.mark();
     
-    uint16_t offset = 0;
-    
-    // Start varbind sequence
-    buffer[offset++] = 0x30; // Sequence tag
-    uint16_t lengthOffset = offset++;
-    
-    // Encode each varbind
-    for (size_t i = 0; i < varBind_count_; i++) {
-        // Start varbind sequence
-        buffer[offset++] = 0x30;
-        uint16_t varbindLengthOffset = offset++;
+    // Encode each varbind, last one first
+    for (size_t i = varBind_count_; i-- > 0;) {
+        uint16_t varbindMark = writer.mark();
         
-        // Convert string OID to numeric and encode
-        uint32_t numericOID[ASN1Object::MAX_OID_LENGTH];
-        size_t oidLength;
-        if (!stringToNumericOID(varBinds_[i].oid, numericOID, &oidLength, ASN1Object::MAX_OID_LENGTH)) {
-            return 0;
+        // Encode value
+        if (!varBinds_[i].value.encode(writer)) {
+            return false;
         }
         
-        ASN1Object oidObj(ASN1Object::Type::OBJECT_IDENTIFIER);
-        oidObj.setOID(numericOID, oidLength);
-        offset += oidObj.encode(buffer + offset, maxSize - offset);
-        
-        // Encode value
-        offset += varBinds_[i].value.encode(buffer + offset, maxSize - offset);
+        // Encoded OID is written as is
+        if (!writer.writeOctetString(ASN1::OBJECT_IDENTIFIER_TAG,
+                                     varBinds_[i].oid, varBinds_[i].oidLength)) {
+            return false;
+        }
         
-        // Update varbind length
-        buffer[varbindLengthOffset] = offset - varbindLengthOffset - 1;
+        writer.endConstructed(ASN1::SEQUENCE_TAG, varbindMark);
     }
     
-    // Update sequence length
-    buffer[lengthOffset] = offset - 2;
-    
-    return offset;
+    return writer.endConstructed(ASN1::SEQUENCE_TAG, listMark);
 }
 
 // createResponse implementation moved to SNMPMessageMIB.cpp
@@ -2,11 +2,17 @@
 #include "MIB.h"
 #include "ASN1Object.h"
 #include <cstddef>
+#include <string.h>
+#include <new>
 
-void SNMPMessage::createResponse(const SNMPMessage& request, MIB& mib) {
+void SNMPMessage::createResponse(const SNMPMessage& request, MIB& mib,
+                                 const char* writeCommunity) {
+    // Nothing is kept from an earlier use of this message
+    clear();
+    
     // Copy request fields
     setVersion(request.getVersion());
-    setCommunity(request.getCommunity());
+    setCommunity(request.getCommunity(), request.getCommunityLength());
     setRequestID(request.getRequestID());
     
     // Set response type
@@ -16,6 +22,15 @@ void SNMPMessage::createResponse(const SNMPMessage& request, MIB& mib) {
     setErrorStatus(0);
     setErrorIndex(0);
     
+    // Varbinds the request could not hold would go unanswered
+    if (request.isTruncated()) {
+        setErrorStatus(1); // tooBig
+        return;
+    }
+    
+    // One block for the answers, when the arena has room for it
+    reserveVarBinds(request.getVarBindViewCount());
+    
     // Process based on request PDU type
     switch (request.getPDUType()) {
         case PDUType::GET_REQUEST:
@@ -24,6 +39,9 @@ void SNMPMessage::createResponse(const SNMPMessage& request, MIB& mib) {
         case PDUType::GET_NEXT_REQUEST:
             this->processGetNextRequest(request, mib);
             break;
+        case PDUType::SET_REQUEST:
+            this->processSetRequest(request, mib, writeCommunity);
+            break;
         default:
             setErrorStatus(5); // genErr
             break;
@@ -31,63 +49,250 @@ void SNMPMessage::createResponse(const SNMPMessage& request, MIB& mib) {
 }
 
 void SNMPMessage::processGetRequest(const SNMPMessage& request, MIB& mib) {
-    // Process each varbind
-    const VarBind* requestVarBinds = request.getVarBinds();
-    size_t varBindCount = request.getVarBindCount();
+    // Resolve every varbind in one pass over the MIB
+    const VarBindView* requestVarBinds = request.getVarBindViews();
+    size_t varBindCount = request.getVarBindViewCount();
+    const MIB::Lookup* lookups = findNodes(request, mib, false);
+    if (!lookups) {
+        return;
+    }
+    uint32_t varBindBytes = 0;
     
     for (size_t i = 0; i < varBindCount; i++) {
-        const VarBind& requestVarBind = requestVarBinds[i];
+        const BERView& requestOid = requestVarBinds[i].oid;
         ASN1Object value;
         
-        // Get value for OID
-        if (!mib.getValue(requestVarBind.oid, value)) {
-            // OID not found
-            setErrorStatus(2); // noSuchName
-            setErrorIndex(i + 1);
-            return;
+        // Get value of the node matched against the packet bytes
+        if (!lookups[i].node || !mib.getValue(*lookups[i].node, value)) {
+            if (version_ == VERSION_1) {
+                // One unknown name fails the whole PDU
+                setErrorStatus(2); // noSuchName
+                setErrorIndex(i + 1);
+                return;
+            }
+            // SNMPv2c answers this varbind and carries on
+            value = ASN1Object(mib.getException(requestOid.data, requestOid.length));
         }
         
         // Add response varbind
-        if (!addVarBind(requestVarBind.oid, value)) {
-            // Too many varbinds
-            setErrorStatus(1); // tooBig
-            setErrorIndex(0);
+        if (!addResponseVarBind(requestOid.data, requestOid.length, value, varBindBytes)) {
             return;
         }
     }
 }
 
 void SNMPMessage::processGetNextRequest(const SNMPMessage& request, MIB& mib) {
-    // Process each varbind
-    const VarBind* requestVarBinds = request.getVarBinds();
-    size_t varBindCount = request.getVarBindCount();
+    // Resolve every varbind in one pass over the MIB
+    const VarBindView* requestVarBinds = request.getVarBindViews();
+    size_t varBindCount = request.getVarBindViewCount();
+    const MIB::Lookup* lookups = findNodes(request, mib, true);
+    if (!lookups) {
+        return;
+    }
+    uint32_t varBindBytes = 0;
     
     for (size_t i = 0; i < varBindCount; i++) {
-        const VarBind& requestVarBind = requestVarBinds[i];
-        char nextOid[MAX_OID_STRING_LENGTH];
+        const BERView& requestOid = requestVarBinds[i].oid;
+        const MIB::Node* next = lookups[i].node;
         ASN1Object value;
         
-        // Get next OID
-        if (!mib.getNextOID(requestVarBind.oid, nextOid, sizeof(nextOid))) {
-            // No next OID available
-            setErrorStatus(2); // noSuchName
-            setErrorIndex(i + 1);
-            return;
+        // Next OID
+        if (!next) {
+            if (version_ == VERSION_1) {
+                // No next OID available
+                setErrorStatus(2); // noSuchName
+                setErrorIndex(i + 1);
+                return;
+            }
+            // SNMPv2c: endOfMibView under the requested name
+            if (!addResponseVarBind(requestOid.data, requestOid.length,
+                                    ASN1Object(ASN1Object::Type::END_OF_MIB_VIEW), varBindBytes)) {
+                return;
+            }
+            continue;
         }
         
         // Get value for next OID
-        if (!mib.getValue(nextOid, value)) {
+        if (!mib.getValue(*next, value)) {
             setErrorStatus(5); // genErr
             setErrorIndex(i + 1);
             return;
         }
         
         // Add response varbind
-        if (!addVarBind(nextOid, value)) {
-            // Too many varbinds
-            setErrorStatus(1); // tooBig
-            setErrorIndex(0);
+        if (!addResponseVarBind(next->oid, next->oidLength, value, varBindBytes)) {
+            return;
+        }
+    }
+}
+
+MIB::Lookup* SNMPMessage::findNodes(const SNMPMessage& request, MIB& mib, bool next) {
+    const VarBindView* requestVarBinds = request.getVarBindViews();
+    size_t varBindCount = request.getVarBindViewCount();
+    MIB::Lookup* lookups = arena_->allocate<MIB::Lookup>(varBindCount);
+    if (!lookups) {
+        // No room to look them up: more than a response could carry
+        setErrorStatus(1); // tooBig
+        return nullptr;
+    }
+    for (size_t i = 0; i < varBindCount; i++) {
+        lookups[i].oid = requestVarBinds[i].oid.data;
+        lookups[i].length = requestVarBinds[i].oid.length;
+    }
+    
+    // One merge pass per MAX_LOOKUPS names
+    for (size_t first = 0; first < varBindCount; first += MIB::MAX_LOOKUPS) {
+        size_t count = varBindCount - first;
+        if (count > MIB::MAX_LOOKUPS) {
+            count = MIB::MAX_LOOKUPS;
+        }
+        if (!mib.findNodes(lookups + first, count, next)) {
+            setErrorStatus(5); // genErr
+            return nullptr;
+        }
+    }
+    return lookups;
+}
+
+void SNMPMessage::processSetRequest(const SNMPMessage& request, MIB& mib,
+                                    const char* writeCommunity) {
+    const VarBindView* requestVarBinds = request.getVarBindViews();
+    size_t varBindCount = request.getVarBindViewCount();
+    
+    // Only the write community may change anything; none (empty) refuses all
+    size_t communityLength = request.getCommunityLength();
+    if (!writeCommunity || writeCommunity[0] == '\0' ||
+        strlen(writeCommunity) != communityLength ||
+        memcmp(writeCommunity, request.getCommunity(), communityLength) != 0) {
+        setSetError(request, MIB::SetError::AUTHORIZATION_ERROR, 0);
+        return;
+    }
+    
+    ASN1Object* values = arena_->allocate<ASN1Object>(varBindCount);
+    if (!values) {
+        setErrorStatus(1); // tooBig
+        return;
+    }
+    
+    // Phase 1: check every varbind before anything changes
+    for (size_t i = 0; i < varBindCount; i++) {
+        const BERView& requestOid = requestVarBinds[i].oid;
+        MIB::SetError error = MIB::SetError::WRONG_ENCODING;
+        new (&values[i]) ASN1Object();
+        if (values[i].decode(requestVarBinds[i].value)) {
+            error = mib.testValue(requestOid.data, requestOid.length, values[i]);
+        }
+        if (error != MIB::SetError::NONE) {
+            setSetError(request, error, i + 1);
             return;
         }
     }
+    
+    // Phase 2: apply them all as one transaction
+    mib.beginSet();
+    for (size_t i = 0; i < varBindCount; i++) {
+        const BERView& requestOid = requestVarBinds[i].oid;
+        if (!mib.setValue(requestOid.data, requestOid.length, values[i])) {
+            bool undone = mib.abortSet() || i == 0;
+            setSetError(request, undone ? MIB::SetError::COMMIT_FAILED : MIB::SetError::UNDO_FAILED, i + 1);
+            return;
+        }
+    }
+    if (!mib.commitSet()) {
+        setSetError(request, MIB::SetError::COMMIT_FAILED, 0);
+        return;
+    }
+    
+    // Echo the varbinds as now stored; the request values point into
+    // the receive buffer, which the response is encoded over
+    uint32_t varBindBytes = 0;
+    for (size_t i = 0; i < varBindCount; i++) {
+        const BERView& requestOid = requestVarBinds[i].oid;
+        ASN1Object value;
+        if (!mib.getValue(requestOid.data, requestOid.length, value)) {
+            setErrorStatus(5); // genErr
+            setErrorIndex(i + 1);
+            return;
+        }
+        if (!addResponseVarBind(requestOid.data, requestOid.length, value, varBindBytes)) {
+            return;
+        }
+    }
+}
+
+void SNMPMessage::setSetError(const SNMPMessage& request, MIB::SetError error, size_t index) {
+    uint8_t status = static_cast<uint8_t>(error);
+    
+    // SNMPv1 has only the RFC 1157 codes (mapping from RFC 2576, 4.3)
+    if (version_ == VERSION_1) {
+        switch (error) {
+            case MIB::SetError::WRONG_TYPE:
+            case MIB::SetError::WRONG_ENCODING:
+            case MIB::SetError::WRONG_VALUE:
+                status = 3; // badValue
+                break;
+            case MIB::SetError::NO_CREATION:
+            case MIB::SetError::NOT_WRITABLE:
+            case MIB::SetError::AUTHORIZATION_ERROR:
+                status = 2; // noSuchName
+                break;
+            default:
+                status = 5; // genErr
+                break;
+        }
+    }
+    
+    setErrorStatus(status);
+    setErrorIndex(index);
+    echoVarBinds(request);
+}
+
+void SNMPMessage::echoVarBinds(const SNMPMessage& request) {
+    const VarBindView* requestVarBinds = request.getVarBindViews();
+    size_t varBindCount = request.getVarBindViewCount();
+    uint32_t varBindBytes = 0;
+    varBind_count_ = 0;
+    
+    for (size_t i = 0; i < varBindCount; i++) {
+        // The value bytes go to the arena: the response is encoded over
+        // the request. One that cannot be kept or decoded is sent as NULL.
+        BERView view = requestVarBinds[i].value;
+        uint8_t* copy = arena_->allocate<uint8_t>(view.length);
+        ASN1Object value;
+        if (copy) {
+            memcpy(copy, view.data, view.length);
+            view.data = copy;
+            if (!value.decode(view)) {
+                value = ASN1Object();
+            }
+        }
+        
+        const BERView& requestOid = requestVarBinds[i].oid;
+        if (!addResponseVarBind(requestOid.data, requestOid.length, value, varBindBytes)) {
+            return;
+        }
+    }
+}
+
+bool SNMPMessage::addResponseVarBind(const uint8_t* oid, size_t oidLength,
+                                     const ASN1Object& value, uint32_t& varBindBytes) {
+    uint16_t size = varBindSize(oidLength, value);
+    if (size == 0) {
+        setErrorStatus(5); // genErr
+        setErrorIndex(varBind_count_ + 1);
+        return false;
+    }
+    
+    // Check the byte budget before adding, so nothing is encoded twice
+    if (sizeWithVarBinds(varBindBytes + size) > MAX_PACKET_SIZE ||
+        !addVarBind(oid, oidLength, value)) {
+        // tooBig carries no varbinds, so the error itself always fits
+        varBind_count_ = 0;
+        setErrorStatus(1); // tooBig
+        setErrorIndex(0);
+        return false;
+    }
+    
+    varBindBytes += size;
+    return true;
 }
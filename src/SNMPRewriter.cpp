@@ -0,0 +1,192 @@
+#include "SNMPRewriter.h"
+#include "ASN1Types.h"
+#include "BERKernels.h"
+#include "BERWriter.h"
+
+using namespace ASN1;
+
+namespace {
+    // INTEGER 0 for error-status and error-index
+    constexpr uint32_t ZERO_INTEGER_SIZE = 3;
+
+    // Header bytes of a TLV with the given content length
+    uint32_t headerSize(uint32_t contentLength) {
+        return BERKernel::tlvSize(contentLength) - contentLength;
+    }
+}
+
+uint16_t SNMPRewriter::rewrite(uint8_t* buffer, uint16_t size, uint16_t capacity,
+                               MIB& mib, const uint8_t*& response) {
+    if (!buffer || size == 0 || size > capacity) {
+        return 0;
+    }
+
+    // Locate every field of the request; views point into buffer
+    BERReader packet(buffer, size);
+    BERView message, version, community, pdu;
+    BERView requestID, errorStatus, errorIndex, list;
+    int32_t integer;
+    if (!packet.read(SEQUENCE_TAG, message)) {
+        return 0;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, version) || !version.getInteger(integer) ||
+        !fields.read(OCTET_STRING_TAG, community) ||
+        community.length >= SNMPMessage::MAX_COMMUNITY_LENGTH ||
+        !fields.read(pdu)) {
+        return 0;
+    }
+
+    bool getNext = pdu.tag == static_cast<uint8_t>(SNMPMessage::PDUType::GET_NEXT_REQUEST);
+    if (!getNext && pdu.tag != static_cast<uint8_t>(SNMPMessage::PDUType::GET_REQUEST)) {
+        return 0;
+    }
+
+    BERReader pduFields(pdu);
+    if (!pduFields.read(INTEGER_TAG, requestID) || !requestID.getInteger(integer) ||
+        !pduFields.read(INTEGER_TAG, errorStatus) ||
+        !pduFields.read(INTEGER_TAG, errorIndex) ||
+        !pduFields.read(SEQUENCE_TAG, list)) {
+        return 0;
+    }
+
+    VarBind varbinds[SNMPMessage::MAX_VARBINDS];
+    size_t count;
+    if (!resolve(list, getNext, mib, varbinds, count)) {
+        return 0;
+    }
+
+    // Raw request regions that move unchanged
+    const uint8_t* versionStart = message.data;
+    const uint8_t* communityStart = version.data + version.length;
+    const uint8_t* pduStart = community.data + community.length;
+    const uint8_t* requestIDStart = pdu.data;
+    const uint8_t* errorStatusStart = requestID.data + requestID.length;
+    const uint8_t* errorIndexStart = errorStatus.data + errorStatus.length;
+    const uint8_t* listStart = errorIndex.data + errorIndex.length;
+
+    // The writer fills the buffer from its end, while the request is
+    // consumed from its end. Before each step writes, the request bytes
+    // it still needs (everything before `start`) must lie below the
+    // writer, so check the whole plan before touching the buffer.
+    uint32_t written = 0;
+    auto fits = [&](const uint8_t* start) {
+        return written + static_cast<uint32_t>(start - buffer) <= capacity;
+    };
+
+    uint32_t listContent = 0;
+    for (size_t i = count; i-- > 0;) {
+        const VarBind& varbind = varbinds[i];
+        uint32_t oidSize = BERKernel::tlvSize(varbind.oidLength);
+        uint32_t content = varbind.valueSize + oidSize;
+
+        written += varbind.valueSize;
+        if (!fits(varbind.valueStart)) return 0;
+        written += oidSize;
+        if (!fits(varbind.oidStart)) return 0;
+        written += headerSize(content);
+        if (!fits(varbind.start)) return 0;
+        listContent += BERKernel::tlvSize(content);
+    }
+
+    written += headerSize(listContent);
+    if (!fits(listStart)) return 0;
+    written += ZERO_INTEGER_SIZE;
+    if (!fits(errorIndexStart)) return 0;
+    written += ZERO_INTEGER_SIZE;
+    if (!fits(errorStatusStart)) return 0;
+    written += errorStatusStart - requestIDStart;
+    if (!fits(requestIDStart)) return 0;
+    written += headerSize(written);
+    if (!fits(pduStart)) return 0;
+    written += pduStart - communityStart;
+    if (!fits(communityStart)) return 0;
+    written += communityStart - versionStart;
+    if (!fits(versionStart)) return 0;
+    written += headerSize(written);
+    if (written > SNMPMessage::MAX_PACKET_SIZE || !fits(buffer)) {
+        return 0;     // Left to the general path, which answers tooBig
+    }
+
+    // Back to front, following the plan above
+    BERWriter writer(buffer, capacity);
+    for (size_t i = count; i-- > 0;) {
+        const VarBind& varbind = varbinds[i];
+        uint16_t mark = writer.mark();
+        if (varbind.encoded) {
+            writer.writeBytes(varbind.encoded, varbind.valueSize);
+        } else {
+            varbind.value.encode(writer);
+        }
+        writer.writeOctetString(OBJECT_IDENTIFIER_TAG, varbind.oid, varbind.oidLength);
+        writer.endConstructed(SEQUENCE_TAG, mark);
+    }
+    writer.endConstructed(SEQUENCE_TAG, 0);
+    writer.writeInteger(INTEGER_TAG, 0);
+    writer.writeInteger(INTEGER_TAG, 0);
+    writer.writeBytes(requestIDStart, errorStatusStart - requestIDStart);
+    writer.endConstructed(static_cast<uint8_t>(SNMPMessage::PDUType::GET_RESPONSE), 0);
+    writer.writeBytes(communityStart, pduStart - communityStart);
+    writer.writeBytes(versionStart, communityStart - versionStart);
+    writer.endConstructed(SEQUENCE_TAG, 0);
+
+    if (!writer.ok() || writer.size() != written) {
+        return 0;
+    }
+    response = writer.data();
+    return writer.size();
+}
+
+bool SNMPRewriter::resolve(const BERView& list, bool getNext, MIB& mib,
+                           VarBind* varbinds, size_t& count) {
+    BERReader entries(list);
+    const uint8_t* next = list.data;
+    MIB::Lookup lookups[SNMPMessage::MAX_VARBINDS];
+    count = 0;
+
+    while (!entries.atEnd()) {
+        BERView entry, oid, value;
+        if (count >= SNMPMessage::MAX_VARBINDS || !entries.read(SEQUENCE_TAG, entry)) {
+            return false;
+        }
+        BERReader entryFields(entry);
+        if (!entryFields.read(OBJECT_IDENTIFIER_TAG, oid) || !entryFields.read(value)) {
+            return false;
+        }
+
+        VarBind& varbind = varbinds[count];
+        varbind.start = next;
+        varbind.oidStart = entry.data;
+        varbind.valueStart = oid.data + oid.length;
+        next = entry.data + entry.length;
+        lookups[count].oid = oid.data;
+        lookups[count].length = oid.length;
+        count++;
+    }
+
+    // Every name in one pass over the MIB; errors are left to the general path
+    if (!mib.findNodes(lookups, count, getNext)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        VarBind& varbind = varbinds[i];
+        const MIB::Node* node = lookups[i].node;
+        if (!node) {
+            return false;
+        }
+        varbind.oid = node->oid;
+        varbind.oidLength = node->oidLength;
+        if (mib.getEncodedValue(*node, varbind.encoded, varbind.valueSize)) {
+            continue;
+        }
+        varbind.encoded = nullptr;
+        if (!mib.getValue(*node, varbind.value)) {
+            return false;
+        }
+        varbind.valueSize = varbind.value.encodedSize();
+        if (varbind.valueSize == 0) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,157 @@
+#include "SNMPStreamDecoder.h"
+#include "ErrorHandler.h"
+#include <string.h>
+
+using Schema = SNMPSchema::Message;
+
+SNMPStreamDecoder::SNMPStreamDecoder(SNMPMessage& message)
+    : message_(message)
+    , parser_({this, onConstructed, onPrimitive, onEnd})
+    , errorReported_(false)
+    , pieceStart_(nullptr)
+{
+    context_.message = &message;
+}
+
+void SNMPStreamDecoder::begin() {
+    message_.varBind_count_ = 0;
+    message_.varBindView_count_ = 0;
+    message_.truncated_ = false;
+    message_.communityView_ = BERView();
+    message_.spillUsed_ = 0;
+
+    parser_.reset();
+    memset(context_.index, 0, sizeof(context_.index));
+    context_.open = 0;
+    context_.error = 0;
+    errorReported_ = false;
+    pieceStart_ = nullptr;
+}
+
+bool SNMPStreamDecoder::feed(const uint8_t* chunk, uint16_t size) {
+    if (parser_.feed(chunk, size)) {
+        return true;
+    }
+
+    // Malformed framing is reported against the field being read
+    if (!errorReported_) {
+        reject(context_.open == 0 ? Schema::ERROR_CODE : Schema::pendingError(context_, 0));
+    }
+    return false;
+}
+
+bool SNMPStreamDecoder::finish() {
+    if (parser_.hasError() || errorReported_) {
+        return false;
+    }
+    if (!parser_.isComplete()) {
+        return reject(Schema::ERROR_CODE);
+    }
+    message_.trimVarBindViews();
+    return true;
+}
+
+bool SNMPStreamDecoder::onConstructed(void* context, uint8_t tag, uint16_t length, uint8_t depth) {
+    SNMPSchema::Event event;
+    event.kind = SNMPSchema::EventKind::BEGIN;
+    event.tag = tag;
+    event.depth = depth;
+    return static_cast<SNMPStreamDecoder*>(context)->dispatch(event);
+}
+
+bool SNMPStreamDecoder::onPrimitive(void* context, uint8_t tag, const uint8_t* data, uint16_t length,
+                                    uint8_t depth, bool carried, bool more) {
+    SNMPStreamDecoder& self = *static_cast<SNMPStreamDecoder*>(context);
+
+    // Content split by the ring wrap is rebuilt in the spill area
+    if (carried || more || self.pieceStart_) {
+        if (!self.retain(data, length, carried, more)) {
+            return false;
+        }
+        if (more) {
+            return true;
+        }
+    }
+
+    SNMPSchema::Event event;
+    event.kind = SNMPSchema::EventKind::VALUE;
+    event.tag = tag;
+    event.depth = depth;
+    event.view.tag = tag;
+    event.view.data = data;
+    event.view.length = length;
+    return self.dispatch(event);
+}
+
+bool SNMPStreamDecoder::onEnd(void* context, uint8_t tag, uint8_t depth) {
+    SNMPSchema::Event event;
+    event.kind = SNMPSchema::EventKind::END;
+    event.tag = tag;
+    event.depth = depth;
+    return static_cast<SNMPStreamDecoder*>(context)->dispatch(event);
+}
+
+bool SNMPStreamDecoder::dispatch(const SNMPSchema::Event& event) {
+    bool ok;
+    if (event.depth > 0) {
+        ok = Schema::route(context_, event, 0);
+    } else if (event.kind == SNMPSchema::EventKind::BEGIN) {
+        ok = Schema::begin(context_, event);
+    } else if (event.kind == SNMPSchema::EventKind::VALUE) {
+        ok = Schema::value(context_, event);
+    } else {
+        ok = Schema::end(context_, 0);
+    }
+
+    if (!ok) {
+        return reject(context_.error);
+    }
+
+    if (event.kind == SNMPSchema::EventKind::BEGIN) {
+        context_.open = event.depth + 1;
+    } else if (event.kind == SNMPSchema::EventKind::END) {
+        context_.open = event.depth;
+    }
+    return true;
+}
+
+bool SNMPStreamDecoder::retain(const uint8_t*& data, uint16_t length, bool carried, bool more) {
+    uint8_t* spill = message_.spill_;
+    uint16_t& used = message_.spillUsed_;
+    if (length > SNMPMessage::SPILL_SIZE - used) {
+        return false;
+    }
+
+    if (!pieceStart_ && (more || carried)) {
+        pieceStart_ = spill + used;
+    }
+    memcpy(spill + used, data, length);
+    used += length;
+
+    if (!more) {
+        // Whole content is now contiguous in the spill area
+        data = pieceStart_;
+        pieceStart_ = nullptr;
+    }
+    return true;
+}
+
+bool SNMPStreamDecoder::reject(uint16_t code) {
+    if (errorReported_) {
+        return false;
+    }
+    errorReported_ = true;
+
+    const char* message;
+    switch (code) {
+        case 0x4003: message = "Failed to decode SNMP sequence"; break;
+        case 0x4004: message = "Failed to decode SNMP version"; break;
+        case 0x4005: message = "Failed to decode community string"; break;
+        default: return false;     // Silently dropped
+    }
+    REPORT_ERROR(ErrorHandler::Severity::WARNING,
+                ErrorHandler::Category::PROTOCOL,
+                code,
+                message);
+    return false;
+}
@@ -14,33 +14,41 @@ SecurityManager::SecurityManager(MIB& mib) : mib_(mib) {
 
 void SecurityManager::initializeMIBNodes() {
     // Initialize MIB nodes for security statistics
-    ASN1Object value(ASN1Object::Type::INTEGER);
-    value.setInteger(0);
-    
     // Register nodes with initial values
-    mib_.registerNode(ACCESS_ATTEMPTS_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+    mib_.registerNode(ACCESS_ATTEMPTS_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(0);
+            ASN1Object value(ASN1Object::Type::COUNTER32);
+            value.setCounter32(0);
             return value;
         });
     
-    mib_.registerNode(INVALID_ACCESSES_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+    mib_.registerNode(INVALID_ACCESSES_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(0);
+            ASN1Object value(ASN1Object::Type::COUNTER32);
+            value.setCounter32(0);
             return value;
         });
     
-    mib_.registerNode(RATE_LIMITED_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+    mib_.registerNode(RATE_LIMITED_OID, MIB::NodeType::COUNTER32, MIB::Access::READ_ONLY,
         []() {
-            ASN1Object value(ASN1Object::Type::INTEGER);
-            value.setInteger(0);
+            ASN1Object value(ASN1Object::Type::COUNTER32);
+            value.setCounter32(0);
             return value;
         });
 }
 
-bool SecurityManager::checkAccess(uint32_t clientIP, const char* community) {
+void SecurityManager::setCommunities(const char* readCommunity, const char* writeCommunity) {
+    readCommunity_ = readCommunity;
+    writeCommunity_ = writeCommunity;
+}
+
+// community need not be NUL-terminated; an empty expected one matches nothing
+static bool sameCommunity(const char* expected, const char* community, size_t length) {
+    return expected && expected[0] != '\0' && strlen(expected) == length &&
+           memcmp(expected, community, length) == 0;
+}
+
+bool SecurityManager::checkAccess(uint32_t clientIP, const char* community, size_t length) {
     unsigned long now = millis();
     bool allowed = true;
     
@@ -48,7 +56,8 @@ bool SecurityManager::checkAccess(uint32_t clientIP, const char* community) {
     incrementCounter(ACCESS_ATTEMPTS_OID);
     
     // Check community string
-    if (strcmp(community, "public") != 0) {  // TODO: Make configurable
+    if (!sameCommunity(readCommunity_, community, length) &&
+        !sameCommunity(writeCommunity_, community, length)) {
         incrementCounter(INVALID_ACCESSES_OID);
         logAccess(clientIP, false, "Invalid community string");
         return false;
@@ -98,19 +107,18 @@ void SecurityManager::setLogFile(FILE* file) {
     logFile_ = file;
 }
 
-void SecurityManager::incrementCounter(const char* oid) {
+void SecurityManager::incrementCounter(const OID& oid) {
     ASN1Object value;
     if (mib_.getValue(oid, value)) {
-        int32_t currentValue = value.getInteger();
-        value.setInteger(currentValue + 1);
+        value.setCounter32(value.getUnsigned() + 1);
         mib_.setValue(oid, value);
     }
 }
 
-uint32_t SecurityManager::getCounterValue(const char* oid) const {
+uint32_t SecurityManager::getCounterValue(const OID& oid) const {
     ASN1Object value;
     if (mib_.getValue(oid, value)) {
-        return value.getInteger();
+        return value.getUnsigned();
     }
     return 0;
 }
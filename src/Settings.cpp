@@ -1,4 +1,5 @@
 #include "Settings.h"
+#include "MIB.h"
 #include <cstring>
 #include "pico/time.h"
 #include "hardware/flash.h"
@@ -12,7 +13,7 @@ static const uint32_t crc32_table[256] = {
     // ... (truncated for brevity - full table would be included in actual implementation)
 };
 
-SettingsManager::SettingsManager() : activeBlock(0) {
+SettingsManager::SettingsManager() : activeBlock(0), batchOpen(false), batchDirty(false) {
     initializeDefaultSettings();
 }
 
@@ -45,6 +46,11 @@ void SettingsManager::initializeDefaultSettings() {
     currentSettings.powerLossCount = 0;
     currentSettings.uptime = 0;
     currentSettings.lastPowerLoss = 0;
+    
+    // System group defaults
+    strncpy(currentSettings.sysContact, "admin@example.com", sizeof(currentSettings.sysContact) - 1);
+    strncpy(currentSettings.sysName, "PowerMonitor", sizeof(currentSettings.sysName) - 1);
+    strncpy(currentSettings.sysLocation, "Server Room", sizeof(currentSettings.sysLocation) - 1);
 }
 
 bool SettingsManager::loadSettings() {
@@ -101,50 +107,170 @@ bool SettingsManager::validateSettings() {
 
 bool SettingsManager::updateSettings(const DeviceSettings& newSettings) {
     currentSettings = newSettings;
-    return saveSettings();
+    return persist();
 }
 
 // Individual setting updates
 bool SettingsManager::setDHCP(bool enabled) {
     currentSettings.dhcpEnabled = enabled;
-    return saveSettings();
+    return persist();
 }
 
 bool SettingsManager::setStaticIP(const uint8_t ip[4]) {
     memcpy(currentSettings.staticIP, ip, 4);
-    return saveSettings();
+    return persist();
 }
 
 bool SettingsManager::setSubnetMask(const uint8_t mask[4]) {
     memcpy(currentSettings.subnetMask, mask, 4);
-    return saveSettings();
+    return persist();
 }
 
 bool SettingsManager::setGateway(const uint8_t gw[4]) {
     memcpy(currentSettings.gateway, gw, 4);
-    return saveSettings();
+    return persist();
 }
 
 bool SettingsManager::setCommunityString(const char* community) {
     strncpy(currentSettings.communityString, community, sizeof(currentSettings.communityString) - 1);
     currentSettings.communityString[sizeof(currentSettings.communityString) - 1] = '\0';
-    return saveSettings();
+    return persist();
+}
+
+bool SettingsManager::setWriteCommunity(const char* community) {
+    strncpy(currentSettings.writeCommunity, community, sizeof(currentSettings.writeCommunity) - 1);
+    currentSettings.writeCommunity[sizeof(currentSettings.writeCommunity) - 1] = '\0';
+    return persist();
 }
 
 bool SettingsManager::setSNMPPort(uint16_t port) {
     currentSettings.snmpPort = port;
-    return saveSettings();
+    return persist();
+}
+
+bool SettingsManager::setTrapDestination(const uint8_t host[4], bool inform) {
+    memcpy(currentSettings.trapHost, host, 4);
+    currentSettings.trapInform = inform;
+    return persist();
 }
 
 bool SettingsManager::setRateLimit(uint32_t limit) {
     currentSettings.rateLimit = limit;
-    return saveSettings();
+    return persist();
+}
+
+bool SettingsManager::setSysContact(const char* contact, size_t length) {
+    return setString(currentSettings.sysContact, sizeof(currentSettings.sysContact), contact, length);
+}
+
+bool SettingsManager::setSysName(const char* name, size_t length) {
+    return setString(currentSettings.sysName, sizeof(currentSettings.sysName), name, length);
+}
+
+bool SettingsManager::setSysLocation(const char* location, size_t length) {
+    return setString(currentSettings.sysLocation, sizeof(currentSettings.sysLocation), location, length);
+}
+
+// Batched updates
+void SettingsManager::beginBatch() {
+    batchSnapshot = currentSettings;
+    batchOpen = true;
+    batchDirty = false;
+}
+
+bool SettingsManager::commitBatch() {
+    bool saved = !batchDirty || saveSettings();
+    if (!saved) {
+        // RAM goes back to what flash still holds
+        currentSettings = batchSnapshot;
+    }
+    batchOpen = false;
+    batchDirty = false;
+    return saved;
+}
+
+void SettingsManager::abortBatch() {
+    if (batchOpen) {
+        currentSettings = batchSnapshot;
+    }
+    batchOpen = false;
+    batchDirty = false;
+}
+
+// DisplayString (RFC 2579): printable ASCII, within the stored size
+template <size_t FieldSize>
+static bool isDisplayString(const ASN1Object& value) {
+    if (value.getStringLength() >= FieldSize) {
+        return false;
+    }
+    const char* text = value.getString();
+    for (size_t i = 0; i < value.getStringLength(); i++) {
+        if (text[i] < 0x20 || text[i] > 0x7E) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SettingsManager::registerMIBNodes(MIB& mib) {
+    // Captureless callbacks reach the settings through a static pointer
+    static SettingsManager* instance = this;
+    
+    static constexpr OID SYS_CONTACT_OID{"1.3.6.1.2.1.1.4"};
+    static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+    static constexpr OID SYS_LOCATION_OID{"1.3.6.1.2.1.1.6"};
+    
+    // sysContact (.1.3.6.1.2.1.1.4)
+    mib.registerNode(SYS_CONTACT_OID, MIB::NodeType::STRING, MIB::Access::READ_WRITE,
+        []() {
+            const char* text = instance->currentSettings.sysContact;
+            ASN1Object value(ASN1Object::Type::OCTET_STRING);
+            value.setStringRef(text, strlen(text));
+            return value;
+        },
+        [](const ASN1Object& value) {
+            return instance->setSysContact(value.getString(), value.getStringLength());
+        },
+        isDisplayString<sizeof(DeviceSettings::sysContact)>);
+    
+    // sysName (.1.3.6.1.2.1.1.5)
+    mib.registerNode(SYS_NAME_OID, MIB::NodeType::STRING, MIB::Access::READ_WRITE,
+        []() {
+            const char* text = instance->currentSettings.sysName;
+            ASN1Object value(ASN1Object::Type::OCTET_STRING);
+            value.setStringRef(text, strlen(text));
+            return value;
+        },
+        [](const ASN1Object& value) {
+            return instance->setSysName(value.getString(), value.getStringLength());
+        },
+        isDisplayString<sizeof(DeviceSettings::sysName)>);
+    
+    // sysLocation (.1.3.6.1.2.1.1.6)
+    mib.registerNode(SYS_LOCATION_OID, MIB::NodeType::STRING, MIB::Access::READ_WRITE,
+        []() {
+            const char* text = instance->currentSettings.sysLocation;
+            ASN1Object value(ASN1Object::Type::OCTET_STRING);
+            value.setStringRef(text, strlen(text));
+            return value;
+        },
+        [](const ASN1Object& value) {
+            return instance->setSysLocation(value.getString(), value.getStringLength());
+        },
+        isDisplayString<sizeof(DeviceSettings::sysLocation)>);
+    
+    // One SET PDU, one flash write
+    mib.setTransaction({
+        []() { instance->beginBatch(); },
+        []() { return instance->commitBatch(); },
+        []() { instance->abortBatch(); }
+    });
 }
 
 // Statistics updates
 void SettingsManager::incrementPowerLossCount() {
     currentSettings.powerLossCount++;
-    saveSettings();
+    persist();
 }
 
 void SettingsManager::updateUptime() {
@@ -158,6 +284,23 @@ void SettingsManager::recordPowerLoss() {
 }
 
 // Private helper functions
+bool SettingsManager::persist() {
+    if (batchOpen) {
+        batchDirty = true;
+        return true;
+    }
+    return saveSettings();
+}
+
+bool SettingsManager::setString(char* field, size_t fieldSize, const char* value, size_t length) {
+    if (!value || length >= fieldSize) {
+        return false;
+    }
+    memcpy(field, value, length);
+    memset(field + length, 0, fieldSize - length);
+    return persist();
+}
+
 bool SettingsManager::findLatestBlock() {
     uint32_t latestVersion = 0;
     bool found = false;
@@ -220,22 +363,22 @@ bool SettingsManager::readBlock(DeviceSettings& settings, uint32_t blockIndex) {
         return false;
     }
     
-    // Verify header
+    // Verify header; blocks from older firmware may be shorter
     BlockHeader* header = reinterpret_cast<BlockHeader*>(blockData);
     if (header->magic != SETTINGS_MAGIC) return false;
-    if (header->dataLength != sizeof(DeviceSettings)) return false;
+    if (header->dataLength > sizeof(DeviceSettings)) return false;
     
     // Verify footer
     BlockFooter* footer = reinterpret_cast<BlockFooter*>(blockData + SETTINGS_BLOCK_SIZE - sizeof(BlockFooter));
     if (footer->marker != SETTINGS_FOOTER) return false;
     
-    // Copy settings data
-    memcpy(&settings, blockData + sizeof(BlockHeader), sizeof(DeviceSettings));
-    
     // Verify CRC32
-    uint32_t calculatedCRC = calculateCRC32(&settings, sizeof(DeviceSettings));
+    const uint8_t* data = blockData + sizeof(BlockHeader);
+    uint32_t calculatedCRC = calculateCRC32(data, header->dataLength);
     if (calculatedCRC != header->crc32) return false;
     
+    // Copy settings data; fields the block lacks keep their values
+    memcpy(&settings, data, header->dataLength);
     return true;
 }
 
@@ -0,0 +1,247 @@
+#include "TrapEmitter.h"
+#include "ASN1Types.h"
+#include "BERConstant.h"
+#include "BERView.h"
+#include "BERWriter.h"
+#include "PowerMonitor.h"
+#include "SNMPMessage.h"
+#include <string.h>
+
+using namespace ASN1;
+
+namespace {
+    // Constant parts of each notification, encoded by the compiler
+    struct Template {
+        BERConstant trapVarBind;                            // snmpTrapOID.0
+        uint8_t valueCount;
+        BERConstant valueNames[TrapEmitter::MAX_VALUES];    // OID TLVs
+        uint8_t valueTags[TrapEmitter::MAX_VALUES];
+    };
+
+    constexpr OID SNMP_TRAP_OID{"1.3.6.1.6.3.1.1.4.1.0"};
+    constexpr OID POWER_LOST_OID{"1.3.6.1.4.1.63050.1.0.1"};
+    constexpr OID POWER_RESTORED_OID{"1.3.6.1.4.1.63050.1.0.2"};
+
+    constexpr BERConstant UPTIME_NAME = BERConstant::oid(OID{"1.3.6.1.2.1.1.3.0"});
+
+    constexpr BERConstant trapVarBind(const OID& notification) {
+        return BERConstant::sequence(BERConstant::oid(SNMP_TRAP_OID), BERConstant::oid(notification));
+    }
+
+    // Indexed by TrapEmitter::Event
+    constexpr Template TEMPLATES[] = {
+        {
+            trapVarBind(POWER_LOST_OID), 2,
+            {BERConstant::oid(PowerMonitor::POWER_STATE_OID),
+             BERConstant::oid(PowerMonitor::POWER_LOSS_COUNT_OID)},
+            {INTEGER_TAG, COUNTER_TAG}
+        },
+        {
+            trapVarBind(POWER_RESTORED_OID), 1,
+            {BERConstant::oid(PowerMonitor::POWER_STATE_OID), BERConstant()},
+            {INTEGER_TAG, 0}
+        }
+    };
+    static_assert(sizeof(TEMPLATES) / sizeof(TEMPLATES[0]) ==
+                  static_cast<size_t>(TrapEmitter::Event::COUNT), "one template per event");
+}
+
+TrapEmitter::TrapEmitter()
+    : eventHead_(0)
+    , eventTail_(0)
+    , remoteIP_(0)
+    , remotePort_(TRAP_PORT)
+    , inform_(false)
+    , headerSize_(0)
+    , nextRequestID_(1)
+    , sent_(0)
+    , acknowledged_(0)
+    , failed_(0)
+    , ringDropped_(0)
+    , queueDropped_(0)
+{
+    for (uint8_t i = 0; i < QUEUE_SIZE; i++) {
+        queue_[i].used = false;
+    }
+}
+
+bool TrapEmitter::setDestination(uint32_t remoteIP, uint16_t remotePort,
+                                 const char* community, bool inform) {
+    size_t communityLength = community ? strlen(community) : 0;
+    if (communityLength >= SNMPMessage::MAX_COMMUNITY_LENGTH) {
+        return false;
+    }
+
+    // Version and community are the same in every notification
+    BERWriter writer(header_, sizeof(header_));
+    writer.writeOctetString(OCTET_STRING_TAG, reinterpret_cast<const uint8_t*>(community),
+                            communityLength);
+    writer.writeInteger(INTEGER_TAG, SNMPMessage::VERSION_2C);
+    if (!writer.ok()) {
+        return false;
+    }
+    headerSize_ = writer.size();
+    memmove(header_, writer.data(), headerSize_);
+
+    remoteIP_ = remoteIP;
+    remotePort_ = remotePort;
+    inform_ = inform;
+    for (uint8_t i = 0; i < QUEUE_SIZE; i++) {
+        queue_[i].used = false;     // Meant for the old destination
+    }
+    return true;
+}
+
+bool TrapEmitter::raise(Event event, uint32_t timestamp, const uint32_t* values) {
+    if (event >= Event::COUNT) {
+        return false;
+    }
+    uint8_t head = eventHead_;
+    uint8_t next = (head + 1) % EVENT_RING_SIZE;
+    if (next == eventTail_) {
+        ringDropped_ = ringDropped_ + 1;
+        return false;
+    }
+
+    RaisedEvent& raised = events_[head];
+    raised.event = event;
+    raised.timestamp = timestamp;
+    const Template& notification = TEMPLATES[static_cast<uint8_t>(event)];
+    for (uint8_t i = 0; i < notification.valueCount; i++) {
+        raised.values[i] = values ? values[i] : 0;
+    }
+
+    // The entry is complete before process() can see it
+    __sync_synchronize();
+    eventHead_ = next;
+    return true;
+}
+
+void TrapEmitter::process(uint32_t now, SendFunction send) {
+    // Encode what was raised since the last call
+    while (eventTail_ != eventHead_) {
+        __sync_synchronize();
+        uint8_t tail = eventTail_;
+        if (remoteIP_ != 0) {
+            enqueue(events_[tail], now);
+        }
+        eventTail_ = (tail + 1) % EVENT_RING_SIZE;
+    }
+
+    for (uint8_t i = 0; i < QUEUE_SIZE; i++) {
+        Outbound& outbound = queue_[i];
+        if (!outbound.used || static_cast<int32_t>(now - outbound.nextAttempt) < 0) {
+            continue;
+        }
+        if (inform_ && outbound.attempts > INFORM_RETRIES) {
+            outbound.used = false;      // Never acknowledged
+            failed_++;
+            continue;
+        }
+
+        if (send && send(outbound.bytes, outbound.size, remoteIP_, remotePort_)) {
+            sent_++;
+        }
+        if (!inform_) {
+            outbound.used = false;      // Traps are not acknowledged
+            continue;
+        }
+        outbound.nextAttempt = now + (INFORM_TIMEOUT_MS << outbound.attempts);
+        outbound.attempts++;
+    }
+}
+
+bool TrapEmitter::enqueue(const RaisedEvent& raised, uint32_t now) {
+    Outbound* outbound = nullptr;
+    for (uint8_t i = 0; !outbound && i < QUEUE_SIZE; i++) {
+        if (!queue_[i].used) {
+            outbound = &queue_[i];
+        }
+    }
+    if (!outbound) {
+        queueDropped_++;
+        return false;
+    }
+
+    // Back to front: values, the constant varbinds, then the headers
+    const Template& notification = TEMPLATES[static_cast<uint8_t>(raised.event)];
+    int32_t requestID = nextRequestID_;
+    nextRequestID_ = (nextRequestID_ == INT32_MAX) ? 1 : nextRequestID_ + 1;
+
+    BERWriter writer(outbound->bytes, MAX_PDU_SIZE);
+    for (uint8_t i = notification.valueCount; i-- > 0;) {
+        uint16_t mark = writer.mark();
+        if (notification.valueTags[i] == INTEGER_TAG) {
+            writer.writeInteger(INTEGER_TAG, static_cast<int32_t>(raised.values[i]));
+        } else {
+            writer.writeUnsigned(notification.valueTags[i], raised.values[i]);
+        }
+        writer.writeBytes(notification.valueNames[i].data(), notification.valueNames[i].size());
+        writer.endConstructed(SEQUENCE_TAG, mark);
+    }
+    writer.writeBytes(notification.trapVarBind.data(), notification.trapVarBind.size());
+    uint16_t mark = writer.mark();
+    writer.writeUnsigned(TIMETICKS_TAG, raised.timestamp);
+    writer.writeBytes(UPTIME_NAME.data(), UPTIME_NAME.size());
+    writer.endConstructed(SEQUENCE_TAG, mark);
+    writer.endConstructed(SEQUENCE_TAG, 0);
+    writer.writeInteger(INTEGER_TAG, 0);
+    writer.writeInteger(INTEGER_TAG, 0);
+    writer.writeInteger(INTEGER_TAG, requestID);
+    writer.endConstructed(static_cast<uint8_t>(inform_ ? SNMPMessage::PDUType::INFORM_REQUEST
+                                                       : SNMPMessage::PDUType::SNMPV2_TRAP), 0);
+    writer.writeBytes(header_, headerSize_);
+    writer.endConstructed(SEQUENCE_TAG, 0);
+    if (!writer.ok()) {
+        return false;
+    }
+
+    outbound->size = writer.size();
+    memmove(outbound->bytes, writer.data(), outbound->size);
+    outbound->used = true;
+    outbound->requestID = requestID;
+    outbound->attempts = 0;
+    outbound->nextAttempt = now;
+    return true;
+}
+
+bool TrapEmitter::handleResponse(const uint8_t* packet, uint16_t size, uint32_t remoteIP) {
+    if (!packet) {
+        return false;
+    }
+
+    BERReader reader(packet, size);
+    BERView message, field, pdu, requestID;
+    int32_t id;
+    if (!reader.read(SEQUENCE_TAG, message)) {
+        return false;
+    }
+    BERReader fields(message);
+    if (!fields.read(INTEGER_TAG, field) || !fields.read(OCTET_STRING_TAG, field) ||
+        !fields.read(static_cast<uint8_t>(SNMPMessage::PDUType::GET_RESPONSE), pdu)) {
+        return false;
+    }
+
+    // An agent never answers a Response, whatever it matches
+    BERReader pduFields(pdu);
+    if (!inform_ || remoteIP != remoteIP_ ||
+        !pduFields.read(INTEGER_TAG, requestID) || !requestID.getInteger(id)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < QUEUE_SIZE; i++) {
+        if (queue_[i].used && queue_[i].requestID == id) {
+            queue_[i].used = false;
+            acknowledged_++;
+            break;
+        }
+    }
+    return true;
+}
+
+uint8_t TrapEmitter::getPending() const {
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < QUEUE_SIZE; i++) {
+        pending += queue_[i].used ? 1 : 0;
+    }
+    return pending;
+}
@@ -28,6 +28,49 @@ void UDPStack::closeSocket(uint8_t socket) {
     eth_.endPacket();
 }
 
+uint8_t UDPStack::receiveBatch(Datagram* datagrams, uint8_t count) {
+    uint8_t received = 0;
+    uint8_t dropped = 0;
+    while (received < count && dropped < count) {
+        int packetSize = eth_.parsePacket();
+        if (packetSize <= 0) {
+            break;      // Queue drained
+        }
+        
+        Datagram& datagram = datagrams[received];
+        if (packetSize > datagram.capacity) {
+            // Too large for any request we answer
+            discard(packetSize);
+            dropped++;
+            continue;
+        }
+        int size = eth_.read(datagram.buffer, packetSize);
+        if (size < packetSize) {
+            // Failed or short read: the rest goes too, never a truncated request
+            discard(packetSize - (size > 0 ? size : 0));
+            dropped++;
+            continue;
+        }
+        datagram.size = size;
+        datagram.remoteIP = eth_.remoteIP();
+        datagram.remotePort = eth_.remotePort();
+        received++;
+    }
+    return received;
+}
+
+void UDPStack::discard(int size) {
+    // Read out, so the next parsePacket() opens the datagram after it
+    uint8_t scratch[DISCARD_CHUNK];
+    while (size > 0) {
+        int chunk = eth_.read(scratch, size < DISCARD_CHUNK ? size : DISCARD_CHUNK);
+        if (chunk <= 0) {
+            break;
+        }
+        size -= chunk;
+    }
+}
+
 bool UDPStack::receivePacket(uint8_t* buffer, uint16_t& size, uint32_t& remoteIP, uint16_t& remotePort) {
     if (!waitForData(0, 1000)) {  // Use socket 0, 1 second timeout
         return false;
@@ -39,6 +82,8 @@ bool UDPStack::receivePacket(uint8_t* buffer, uint16_t& size, uint32_t& remoteIP
     }
     
     size = eth_.read(buffer, packetSize);
+    remoteIP = eth_.remoteIP();
+    remotePort = eth_.remotePort();
     return size > 0;
 }
 
@@ -1,7 +1,9 @@
 #include "W5500.h"
 
 W5500::W5500(uint8_t cs_pin, uint8_t rst_pin, uint8_t int_pin)
-    : _cs_pin(cs_pin)
+    : _remote_ip(0)
+    , _remote_port(0)
+    , _cs_pin(cs_pin)
     , _rst_pin(rst_pin)
     , _int_pin(int_pin)
     , _dhcp_enabled(false) {
@@ -163,7 +165,8 @@ size_t W5500::write(const uint8_t* buffer, size_t size) {
 }
 
 int W5500::parsePacket() {
-    // TODO: Implement UDP packet parsing
+    // TODO: Implement UDP packet parsing; set _remote_ip/_remote_port
+    // from the datagram header. Must not wait: 0 when nothing is queued.
     return 0;
 }
 
@@ -15,6 +15,7 @@
 #include "MIB.h"
 #include "SNMPMessage.h"
 #include "SNMPAgent.h"
+#include "TrapEmitter.h"
 
 // Pin and Configuration Constants
 const uint8_t POWER_MONITOR_PIN = 27;  // GPIO27 for mains power detection
@@ -40,7 +41,8 @@ FactoryResetHandler factoryReset(settings);
 SerialCom serial;
 CLI cliHandler(serial, settings);
 MIB mib;
-PowerMonitor powerMonitor(mib);
+TrapEmitter traps;
+PowerMonitor powerMonitor(mib, traps);
 SecurityManager security(mib);
 CircuitProtection circuitProtection;
 
@@ -158,6 +160,14 @@ void setup() {
         REPORT_WARNING(ErrorHandler::Category::SYSTEM, 0x1001, "Using default settings");
     }
     
+    // Communities are read from the settings on every request
+    const DeviceSettings& communities = settings.getSettings();
+    security.setCommunities(communities.communityString, communities.writeCommunity);
+    
+    // Writable system group nodes are stored in settings
+    settings.registerMIBNodes(mib);
+    SNMPAgent::registerMIBNodes(mib);
+    
     // Configure SPI pins for W5500
     pinMode(W5500_MISO, INPUT);
     pinMode(W5500_MOSI, OUTPUT);
@@ -197,6 +207,12 @@ void setup() {
     
     serial.sendln("Network initialization complete!");
     
+    // Notifications go to the manager configured with "set trap"
+    uint32_t trapHost;
+    memcpy(&trapHost, deviceSettings.trapHost, sizeof(trapHost));
+    traps.setDestination(trapHost, TrapEmitter::TRAP_PORT, deviceSettings.communityString,
+                         deviceSettings.trapInform);
+    
     // Update uptime initially
     settings.updateUptime();
 }
@@ -232,8 +248,13 @@ void loop() {
         lastUptimeUpdate = currentTime;
     }
     
-    // Process SNMP messages
-    SNMPAgent::processMessages(udp, security, mib);
+    // Process SNMP messages already queued
+    uint8_t handled = SNMPAgent::processMessages(udp, security, mib, traps);
+    
+    // Send raised notifications and due inform retries
+    traps.process(millis(), [](const uint8_t* data, uint16_t size, uint32_t remoteIP, uint16_t remotePort) {
+        return udp.sendPacket(data, size, remoteIP, remotePort);
+    });
     
     // Check system health
     if (!ErrorHandler::getInstance().isSystemHealthy()) {
@@ -242,5 +263,8 @@ void loop() {
         digitalWrite(LED_PIN, LOW);
     }
     
-    delay(10); // Small delay to prevent tight looping
+    // Only rest when idle, so throughput follows load
+    if (handled == 0) {
+        delay(1);
+    }
 }
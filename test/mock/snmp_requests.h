@@ -0,0 +1,39 @@
+#ifndef SNMP_REQUESTS_H
+#define SNMP_REQUESTS_H
+
+#include "SNMPMessage.h"
+#include "MIB.h"
+
+// Request and response builders shared by the SNMP unit tests
+
+// Encoded request naming each OID with a NULL value, community "public".
+// Returns its length; 0 when it does not fit in capacity.
+inline uint16_t buildRequest(SNMPMessage::PDUType type, int32_t requestID,
+                             const OID* oids, size_t count,
+                             uint8_t* buffer, uint16_t capacity,
+                             uint8_t version = SNMPMessage::VERSION_1) {
+    SNMPMessage message;
+    ASN1Object null;
+    message.setVersion(version);
+    message.setCommunity("public");
+    message.setPDUType(type);
+    message.setRequestID(requestID);
+    for (size_t i = 0; i < count; i++) {
+        message.addVarBind(oids[i], null);
+    }
+    return message.encode(buffer, capacity);
+}
+
+// Encoded response from the general path (SNMPMessage::createResponse)
+inline uint16_t encodeResponse(const uint8_t* request, uint16_t size, MIB& mib,
+                               uint8_t* buffer, uint16_t capacity) {
+    SNMPMessage message;
+    if (!message.decode(request, size)) {
+        return 0;
+    }
+    SNMPMessage response;
+    response.createResponse(message, mib);
+    return response.encode(buffer, capacity);
+}
+
+#endif // SNMP_REQUESTS_H
@@ -0,0 +1,203 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "BERKernels.h"
+
+// Microbenchmark for the BER primitive kernels against the shift loops
+// they replaced. Runs natively (pio test -e bench_native) or on the
+// Pico (test_performance env); each case also checks that both versions
+// produce identical octets.
+
+#ifdef TEST_NATIVE
+#include <chrono>
+static uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#else
+#include <Arduino.h>
+static uint64_t nowNs() {
+    return static_cast<uint64_t>(micros()) * 1000;
+}
+#endif
+
+static constexpr size_t VALUE_COUNT = 1024;
+static constexpr uint32_t ITERATIONS = 2000;
+
+static int32_t integers[VALUE_COUNT];
+static uint32_t lengths[VALUE_COUNT];
+static uint32_t subids[VALUE_COUNT];
+static volatile uint32_t sink;
+
+// Legacy encoders, as they were before the kernels
+
+static uint8_t legacyInteger(uint8_t* out, int32_t value) {
+    uint8_t temp[4];
+    uint8_t size = 0;
+    do {
+        temp[size++] = value & 0xFF;
+        value >>= 8;
+    } while (!((value == 0 && !(temp[size - 1] & 0x80)) ||
+               (value == -1 && (temp[size - 1] & 0x80))));
+    for (uint8_t i = 0; i < size; i++) {
+        out[i] = temp[size - 1 - i];
+    }
+    return size;
+}
+
+static uint8_t legacyLength(uint8_t* out, uint32_t length) {
+    if (length < 128) {
+        out[0] = length;
+        return 1;
+    }
+    uint8_t numBytes = 0;
+    for (uint32_t temp = length; temp > 0; temp >>= 8) {
+        numBytes++;
+    }
+    out[0] = 0x80 | numBytes;
+    for (uint8_t i = 0; i < numBytes; i++) {
+        out[numBytes - i] = length & 0xFF;
+        length >>= 8;
+    }
+    return numBytes + 1;
+}
+
+static uint8_t legacySubidentifier(uint8_t* out, uint32_t value) {
+    uint8_t temp[5];
+    uint8_t size = 0;
+    do {
+        temp[size] = (value & 0x7F) | (size > 0 ? 0x80 : 0);
+        size++;
+        value >>= 7;
+    } while (value > 0);
+    for (uint8_t i = 0; i < size; i++) {
+        out[i] = temp[size - 1 - i];
+    }
+    return size;
+}
+
+// Spread values over every encoded width, like real counters and OIDs
+static void fillValues() {
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < VALUE_COUNT; i++) {
+        seed = seed * 1664525 + 1013904223;
+        uint32_t shift = seed % 32;
+        uint32_t value = seed >> shift;
+        integers[i] = (seed & 1) ? -static_cast<int32_t>(value >> 1) : static_cast<int32_t>(value >> 1);
+        lengths[i] = value & 0xFFFF;
+        subids[i] = value;
+    }
+    integers[0] = INT32_MIN;
+    integers[1] = INT32_MAX;
+    subids[0] = 0xFFFFFFFF;
+    subids[1] = 0;
+}
+
+template <typename T, typename Encoder>
+static double timeEncoder(const T* values, Encoder encode) {
+    uint8_t out[8];
+    uint32_t total = 0;
+    uint64_t start = nowNs();
+    for (uint32_t n = 0; n < ITERATIONS; n++) {
+        for (size_t i = 0; i < VALUE_COUNT; i++) {
+            total += encode(out, values[i]);
+            total += out[0];
+        }
+    }
+    uint64_t elapsed = nowNs() - start;
+    sink = total;
+    return static_cast<double>(elapsed) / (static_cast<double>(ITERATIONS) * VALUE_COUNT);
+}
+
+static void report(const char* name, double before, double after) {
+    char line[96];
+    snprintf(line, sizeof(line), "%-14s before %6.2f ns/op  after %6.2f ns/op  (%.2fx)",
+             name, before, after, after > 0 ? before / after : 0.0);
+    TEST_MESSAGE(line);
+}
+
+void setUp(void) {
+    fillValues();
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_kernels_match_legacy() {
+    uint8_t expected[8];
+    uint8_t actual[8];
+    for (size_t i = 0; i < VALUE_COUNT; i++) {
+        uint8_t size = legacyInteger(expected, integers[i]);
+        TEST_ASSERT_EQUAL(size, BERKernel::integerSize(integers[i]));
+        TEST_ASSERT_EQUAL(size, BERKernel::writeInteger(actual, integers[i]));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, size);
+
+        size = legacyLength(expected, lengths[i]);
+        TEST_ASSERT_EQUAL(size, BERKernel::lengthSize(lengths[i]));
+        TEST_ASSERT_EQUAL(size, BERKernel::writeLength(actual, lengths[i]));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, size);
+
+        size = legacySubidentifier(expected, subids[i]);
+        TEST_ASSERT_EQUAL(size, BERKernel::subidentifierSize(subids[i]));
+        TEST_ASSERT_EQUAL(size, BERKernel::writeSubidentifier(actual, subids[i]));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, size);
+    }
+}
+
+void test_unsigned_and_64bit_sizes() {
+    uint8_t out[9];
+    TEST_ASSERT_EQUAL(1, BERKernel::unsignedSize(static_cast<uint32_t>(127)));
+    TEST_ASSERT_EQUAL(2, BERKernel::unsignedSize(static_cast<uint32_t>(128)));
+    TEST_ASSERT_EQUAL(5, BERKernel::writeUnsigned(out, static_cast<uint32_t>(0xFFFFFFFF)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, out[1]);
+
+    TEST_ASSERT_EQUAL(9, BERKernel::writeUnsigned(out, static_cast<uint64_t>(0x8000000000000000ull)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[8]);
+
+    TEST_ASSERT_EQUAL(8, BERKernel::integerSize(static_cast<int64_t>(INT64_MIN)));
+    TEST_ASSERT_EQUAL(5, BERKernel::integerSize(static_cast<int64_t>(0x80000000ll)));
+    TEST_ASSERT_EQUAL(5, BERKernel::lengthSize(0xFFFFFFFFu));
+}
+
+void test_kernel_throughput() {
+    report("integer", timeEncoder(integers, legacyInteger),
+           timeEncoder(integers, [](uint8_t* out, int32_t v) { return BERKernel::writeInteger(out, v); }));
+    report("length", timeEncoder(lengths, legacyLength),
+           timeEncoder(lengths, [](uint8_t* out, uint32_t v) { return BERKernel::writeLength(out, v); }));
+    report("subidentifier", timeEncoder(subids, legacySubidentifier),
+           timeEncoder(subids, [](uint8_t* out, uint32_t v) { return BERKernel::writeSubidentifier(out, v); }));
+}
+
+static void runTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_kernels_match_legacy);
+    RUN_TEST(test_unsigned_and_64bit_sizes);
+    RUN_TEST(test_kernel_throughput);
+
+    UNITY_END();
+}
+
+#ifdef TEST_NATIVE
+int main() {
+    runTests();
+    return 0;
+}
+#else
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    runTests();
+}
+
+void loop() {
+    delay(100);
+}
+#endif
@@ -0,0 +1,135 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "ASN1Types.h"
+#include "BERWriter.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_counter32_encoding() {
+    uint8_t buffer[16];
+
+    // Top bit set needs a leading zero, never a negative INTEGER
+    Counter32 counter(0xFFFFFFFF);
+    uint8_t expected[] = {COUNTER_TAG, 0x05, 0x00, 0xFF, 0xFF, 0xFF, 0xFF};
+    TEST_ASSERT_EQUAL(sizeof(expected), counter.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, sizeof(expected));
+
+    Counter32 decoded;
+    size_t bytesRead = 0;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, sizeof(expected), bytesRead));
+    TEST_ASSERT_EQUAL(sizeof(expected), bytesRead);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, decoded.getValue());
+
+    // Wrong tag
+    Gauge32 gauge;
+    TEST_ASSERT_FALSE(gauge.decode(buffer, sizeof(expected), bytesRead));
+}
+
+void test_gauge_and_timeticks_encoding() {
+    uint8_t buffer[16];
+
+    Gauge32 gauge(128);
+    uint8_t expectedGauge[] = {GAUGE_TAG, 0x02, 0x00, 0x80};
+    TEST_ASSERT_EQUAL(sizeof(expectedGauge), gauge.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expectedGauge, buffer, sizeof(expectedGauge));
+
+    // 2^31 + 1 hundredths, past the point where INTEGER would wrap
+    TimeTicks ticks(0x80000001);
+    TEST_ASSERT_EQUAL(7, ticks.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8(TIMETICKS_TAG, buffer[0]);
+
+    TimeTicks decoded;
+    size_t bytesRead = 0;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, 7, bytesRead));
+    TEST_ASSERT_EQUAL_UINT32(0x80000001, decoded.getValue());
+}
+
+void test_counter64_encoding() {
+    uint8_t buffer[16];
+
+    Counter64 counter(0xFFFFFFFFFFFFFFFFull);
+    TEST_ASSERT_EQUAL(11, counter.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8(COUNTER64_TAG, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x09, buffer[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, buffer[2]);
+
+    Counter64 decoded;
+    size_t bytesRead = 0;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, 11, bytesRead));
+    TEST_ASSERT_TRUE(decoded.getValue() == 0xFFFFFFFFFFFFFFFFull);
+
+    // Nine octets are only valid with a leading zero
+    buffer[2] = 0x01;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, 11, bytesRead));
+}
+
+void test_ip_address_encoding() {
+    uint8_t address[] = {192, 168, 1, 10};
+    uint8_t buffer[8];
+
+    IpAddress ip(address);
+    uint8_t expected[] = {IPADDRESS_TAG, 0x04, 192, 168, 1, 10};
+    TEST_ASSERT_EQUAL(sizeof(expected), ip.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, sizeof(expected));
+
+    IpAddress decoded;
+    size_t bytesRead = 0;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, sizeof(expected), bytesRead));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(address, decoded.getValue(), 4);
+
+    // Must be exactly four octets
+    uint8_t shortAddress[] = {IPADDRESS_TAG, 0x03, 10, 0, 0};
+    TEST_ASSERT_FALSE(decoded.decode(shortAddress, sizeof(shortAddress), bytesRead));
+}
+
+void test_writer_matches_forward_encoder() {
+    ASN1Object values[3];
+    values[0].setCounter32(0x80000000);
+    values[1].setTimeTicks(12345);
+    values[2].setCounter64(0x0000000100000000ull);
+
+    for (size_t i = 0; i < 3; i++) {
+        uint8_t expected[16];
+        uint8_t buffer[16];
+        uint16_t length = values[i].encode(expected, sizeof(expected));
+        BERWriter writer(buffer, sizeof(buffer));
+        TEST_ASSERT_TRUE(values[i].encode(writer));
+        TEST_ASSERT_EQUAL(length, writer.size());
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, writer.data(), length);
+    }
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_counter32_encoding);
+    RUN_TEST(test_gauge_and_timeticks_encoding);
+    RUN_TEST(test_counter64_encoding);
+    RUN_TEST(test_ip_address_encoding);
+    RUN_TEST(test_writer_matches_forward_encoder);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,112 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "ASN1Object.h"
+#include "ASN1Types.h"
+#include "OID.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_object_is_compact() {
+    TEST_ASSERT_TRUE(sizeof(ASN1Object) <= 24);
+    // Typed views add no storage and no vtable
+    TEST_ASSERT_EQUAL(sizeof(ASN1Object), sizeof(OctetString));
+    TEST_ASSERT_EQUAL(sizeof(ASN1Object), sizeof(ObjectIdentifier));
+}
+
+void test_inline_and_referenced_strings() {
+    char text[] = "PowerMonitor";
+    ASN1Object copied;
+    TEST_ASSERT_TRUE(copied.setString(text, strlen(text)));
+    text[0] = 'X';
+    TEST_ASSERT_EQUAL_STRING_LEN("PowerMonitor", copied.getString(), 12);
+
+    // Too long to copy inline
+    const char* description = "SNMP Power Monitor v1.0";
+    TEST_ASSERT_FALSE(copied.setString(description, strlen(description)));
+
+    ASN1Object referenced;
+    referenced.setStringRef(description, strlen(description));
+    TEST_ASSERT_TRUE(referenced.getString() == description);
+
+    uint8_t buffer[32];
+    uint16_t length = referenced.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(25, length);
+    TEST_ASSERT_EQUAL_HEX8(OCTET_STRING_TAG, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8(23, buffer[1]);
+}
+
+void test_oid_storage_forms() {
+    static constexpr OID ENTERPRISE_OID{"1.3.6.1.4.1.63050.1"};
+    uint32_t components[] = {1, 3, 6, 1, 4, 1, 63050, 1};
+    uint8_t expected[16];
+    uint8_t buffer[16];
+
+    ASN1Object referenced;
+    referenced.setOIDRef(ENTERPRISE_OID);
+    uint16_t length = referenced.encode(expected, sizeof(expected));
+    TEST_ASSERT_EQUAL(11, length);
+
+    // Inline copy and referenced components encode identically
+    ASN1Object copied;
+    TEST_ASSERT_TRUE(copied.setOID(components, 8));
+    TEST_ASSERT_EQUAL(length, copied.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, length);
+
+    ASN1Object byComponents;
+    byComponents.setOIDRef(components, 8);
+    TEST_ASSERT_EQUAL(length, byComponents.encode(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, length);
+
+    OID decoded;
+    TEST_ASSERT_TRUE(byComponents.getOID(decoded));
+    TEST_ASSERT_TRUE(decoded == ENTERPRISE_OID);
+}
+
+void test_decode_references_buffer() {
+    uint8_t buffer[] = {OCTET_STRING_TAG, 0x04, 't', 'e', 's', 't', INTEGER_TAG, 0x01, 0x2A};
+    uint16_t offset = 0;
+
+    ASN1Object text;
+    TEST_ASSERT_TRUE(text.decode(buffer, sizeof(buffer), offset));
+    TEST_ASSERT_EQUAL(6, offset);
+    TEST_ASSERT_TRUE(reinterpret_cast<const uint8_t*>(text.getString()) == buffer + 2);
+
+    ASN1Object number;
+    TEST_ASSERT_TRUE(number.decode(buffer, sizeof(buffer), offset));
+    TEST_ASSERT_EQUAL(sizeof(buffer), offset);
+    TEST_ASSERT_EQUAL(42, number.getInteger());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_object_is_compact);
+    RUN_TEST(test_inline_and_referenced_strings);
+    RUN_TEST(test_oid_storage_forms);
+    RUN_TEST(test_decode_references_buffer);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "BERView.h"
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+
+using namespace ASN1;
+
+// GetRequest, community "public", request-id 0x1234,
+// varbinds sysDescr.0 and sysUpTime.0
+static const uint8_t GET_REQUEST[] = {
+    0x30, 0x36,
+    0x02, 0x01, 0x00,
+    0x04, 0x06, 'p', 'u', 'b', 'l', 'i', 'c',
+    0xA0, 0x29,
+    0x02, 0x02, 0x12, 0x34,
+    0x02, 0x01, 0x00,
+    0x02, 0x01, 0x00,
+    0x30, 0x1D,
+    0x30, 0x0C, 0x06, 0x08, 0x2B, 0x06, 0x01, 0x02, 0x01, 0x01, 0x01, 0x00, 0x05, 0x00,
+    0x30, 0x0D, 0x06, 0x09, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01, 0x05, 0x00
+};
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_reader_splits_tlvs() {
+    uint8_t buffer[] = {INTEGER_TAG, 0x01, 0x2A, NULL_TAG, 0x00};
+    BERReader reader(buffer, sizeof(buffer));
+    BERView element;
+
+    TEST_ASSERT_TRUE(reader.read(INTEGER_TAG, element));
+    TEST_ASSERT_TRUE(element.data == buffer + 2);
+    TEST_ASSERT_EQUAL(1, element.length);
+
+    int32_t value = 0;
+    TEST_ASSERT_TRUE(element.getInteger(value));
+    TEST_ASSERT_EQUAL(42, value);
+
+    TEST_ASSERT_TRUE(reader.read(NULL_TAG, element));
+    TEST_ASSERT_EQUAL(0, element.length);
+    TEST_ASSERT_TRUE(reader.atEnd());
+}
+
+void test_reader_long_form_length() {
+    uint8_t buffer[3 + 200];
+    buffer[0] = OCTET_STRING_TAG;
+    buffer[1] = 0x81;
+    buffer[2] = 200;
+    memset(buffer + 3, 'A', 200);
+
+    BERReader reader(buffer, sizeof(buffer));
+    BERView element;
+    TEST_ASSERT_TRUE(reader.read(element));
+    TEST_ASSERT_EQUAL(200, element.length);
+    TEST_ASSERT_TRUE(element.data == buffer + 3);
+}
+
+void test_reader_rejects_truncated() {
+    uint8_t buffer[] = {SEQUENCE_TAG, 0x04, 0x02, 0x01};
+    BERReader reader(buffer, sizeof(buffer));
+    BERView element;
+    TEST_ASSERT_FALSE(reader.read(element));
+}
+
+void test_view_integer_sign_extension() {
+    uint8_t negative[] = {0xFF, 0x7F};
+    BERView view;
+    view.tag = INTEGER_TAG;
+    view.data = negative;
+    view.length = sizeof(negative);
+
+    int32_t value = 0;
+    TEST_ASSERT_TRUE(view.getInteger(value));
+    TEST_ASSERT_EQUAL(-129, value);
+}
+
+void test_view_oid_components() {
+    uint8_t content[] = {0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01};
+    BERView view;
+    view.tag = OBJECT_IDENTIFIER_TAG;
+    view.data = content;
+    view.length = sizeof(content);
+
+    uint32_t components[16];
+    size_t count = 0;
+    TEST_ASSERT_TRUE(view.getOID(components, count, 16));
+    TEST_ASSERT_EQUAL(8, count);
+    TEST_ASSERT_EQUAL(1, components[0]);
+    TEST_ASSERT_EQUAL(3, components[1]);
+    TEST_ASSERT_EQUAL(63050, components[6]);
+    TEST_ASSERT_EQUAL(1, components[7]);
+}
+
+void test_message_decode_references_buffer() {
+    SNMPMessage message;
+    TEST_ASSERT_TRUE(message.decode(GET_REQUEST, sizeof(GET_REQUEST)));
+
+    TEST_ASSERT_EQUAL(0, message.getVersion());
+    TEST_ASSERT_EQUAL(0x1234, message.getRequestID());
+    TEST_ASSERT_TRUE(message.getPDUType() == SNMPMessage::PDUType::GET_REQUEST);
+
+    // Community points into the packet, nothing was copied
+    TEST_ASSERT_EQUAL(6, message.getCommunityLength());
+    TEST_ASSERT_TRUE(message.getCommunity() == reinterpret_cast<const char*>(GET_REQUEST + 7));
+
+    TEST_ASSERT_EQUAL(2, message.getVarBindViewCount());
+    const SNMPMessage::VarBindView* varbinds = message.getVarBindViews();
+    TEST_ASSERT_TRUE(varbinds[0].oid.data == GET_REQUEST + 31);
+    TEST_ASSERT_EQUAL(8, varbinds[0].oid.length);
+    TEST_ASSERT_EQUAL(NULL_TAG, varbinds[0].value.tag);
+    TEST_ASSERT_EQUAL(9, varbinds[1].oid.length);
+}
+
+void test_message_decode_rejects_bad_varbind() {
+    uint8_t packet[sizeof(GET_REQUEST)];
+    memcpy(packet, GET_REQUEST, sizeof(packet));
+    packet[29] = INTEGER_TAG;  // First varbind OID tag corrupted
+
+    SNMPMessage message;
+    TEST_ASSERT_FALSE(message.decode(packet, sizeof(packet)));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_reader_splits_tlvs);
+    RUN_TEST(test_reader_long_form_length);
+    RUN_TEST(test_reader_rejects_truncated);
+    RUN_TEST(test_view_integer_sign_extension);
+    RUN_TEST(test_view_oid_components);
+    RUN_TEST(test_message_decode_references_buffer);
+    RUN_TEST(test_message_decode_rejects_bad_varbind);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "BERWriter.h"
+#include "BERView.h"
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_writer_integer_minimal_octets() {
+    uint8_t buffer[16];
+    struct { int32_t value; uint8_t expected[6]; uint8_t length; } cases[] = {
+        {0,          {0x02, 0x01, 0x00}, 3},
+        {127,        {0x02, 0x01, 0x7F}, 3},
+        {128,        {0x02, 0x02, 0x00, 0x80}, 4},
+        {-128,       {0x02, 0x01, 0x80}, 3},
+        {-129,       {0x02, 0x02, 0xFF, 0x7F}, 4},
+        {INT32_MAX,  {0x02, 0x04, 0x7F, 0xFF, 0xFF, 0xFF}, 6},
+        {INT32_MIN,  {0x02, 0x04, 0x80, 0x00, 0x00, 0x00}, 6},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        BERWriter writer(buffer, sizeof(buffer));
+        TEST_ASSERT_TRUE(writer.writeInteger(INTEGER_TAG, cases[i].value));
+        TEST_ASSERT_EQUAL(cases[i].length, writer.size());
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(cases[i].expected, writer.data(), cases[i].length);
+    }
+}
+
+void test_writer_oid() {
+    uint32_t components[] = {1, 3, 6, 1, 4, 1, 63050, 1};
+    uint8_t expected[] = {0x06, 0x09, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01};
+    uint8_t buffer[16];
+
+    BERWriter writer(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(writer.writeOID(components, 8));
+    TEST_ASSERT_EQUAL(sizeof(expected), writer.size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, writer.data(), sizeof(expected));
+}
+
+void test_writer_long_form_lengths() {
+    uint8_t content[300];
+    memset(content, 'x', sizeof(content));
+    uint8_t buffer[320];
+
+    BERWriter writer(buffer, sizeof(buffer));
+    uint16_t mark = writer.mark();
+    TEST_ASSERT_TRUE(writer.writeOctetString(OCTET_STRING_TAG, content, 200));
+    TEST_ASSERT_TRUE(writer.endConstructed(SEQUENCE_TAG, mark));
+
+    // SEQUENCE 0x81 0xCB { OCTET STRING 0x81 0xC8 ... }
+    const uint8_t* out = writer.data();
+    TEST_ASSERT_EQUAL(206, writer.size());
+    TEST_ASSERT_EQUAL_HEX8(SEQUENCE_TAG, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x81, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(203, out[2]);
+    TEST_ASSERT_EQUAL_HEX8(OCTET_STRING_TAG, out[3]);
+    TEST_ASSERT_EQUAL_HEX8(0x81, out[4]);
+    TEST_ASSERT_EQUAL_HEX8(200, out[5]);
+
+    BERWriter wide(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(wide.writeOctetString(OCTET_STRING_TAG, content, 300));
+    TEST_ASSERT_EQUAL_HEX8(0x82, wide.data()[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, wide.data()[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x2C, wide.data()[3]);
+}
+
+void test_writer_overflow() {
+    uint8_t buffer[4];
+    BERWriter writer(buffer, sizeof(buffer));
+    uint8_t content[8] = {0};
+
+    TEST_ASSERT_FALSE(writer.writeOctetString(OCTET_STRING_TAG, content, sizeof(content)));
+    TEST_ASSERT_FALSE(writer.ok());
+    TEST_ASSERT_FALSE(writer.writeNull());
+}
+
+void test_message_with_sixteen_varbinds() {
+    SNMPMessage response;
+    response.setCommunity("public");
+    response.setPDUType(SNMPMessage::PDUType::GET_RESPONSE);
+    response.setRequestID(0x01020304);
+
+    uint32_t components[] = {1, 3, 6, 1, 4, 1, 63050, 1, 0, 0};
+    for (uint32_t i = 0; i < 16; i++) {
+        OID oid;
+        components[8] = i + 1;
+        TEST_ASSERT_TRUE(OID::fromComponents(components, 10, oid));
+        ASN1Object value(ASN1Object::Type::OCTET_STRING);
+        value.setStringRef("power monitor value", 19);
+        TEST_ASSERT_TRUE(response.addVarBind(oid, value));
+    }
+
+    uint8_t buffer[1500];
+    uint16_t length = response.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_GREATER_THAN(255, length);
+
+    // Multi-byte lengths must decode back to exactly the same message
+    SNMPMessage decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, length));
+    TEST_ASSERT_EQUAL(0x01020304, decoded.getRequestID());
+    TEST_ASSERT_EQUAL(16, decoded.getVarBindViewCount());
+    TEST_ASSERT_EQUAL(19, decoded.getVarBindViews()[15].value.length);
+
+    BERReader reader(buffer, length);
+    BERView message;
+    TEST_ASSERT_TRUE(reader.read(SEQUENCE_TAG, message));
+    TEST_ASSERT_TRUE(reader.atEnd());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_writer_integer_minimal_octets);
+    RUN_TEST(test_writer_oid);
+    RUN_TEST(test_writer_long_form_lengths);
+    RUN_TEST(test_writer_overflow);
+    RUN_TEST(test_message_with_sixteen_varbinds);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
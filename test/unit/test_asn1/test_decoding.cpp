@@ -43,7 +43,8 @@ void test_octet_string_decoding() {
     
     TEST_ASSERT_TRUE(result);
     TEST_ASSERT_EQUAL(6, bytesRead);
-    TEST_ASSERT_EQUAL_STRING("test", testStr.getValue());
+    TEST_ASSERT_EQUAL(4, testStr.getLength());
+    TEST_ASSERT_EQUAL_STRING_LEN("test", testStr.getValue(), 4);
 }
 
 void test_null_decoding() {
@@ -79,9 +80,12 @@ void test_oid_decoding() {
     
     TEST_ASSERT_TRUE(result);
     TEST_ASSERT_EQUAL(7, bytesRead);
-    TEST_ASSERT_EQUAL(6, testOid.getComponentCount());
     
-    const uint32_t* components = testOid.getComponents();
+    OID oid;
+    TEST_ASSERT_TRUE(testOid.getValue(oid));
+    TEST_ASSERT_EQUAL(6, oid.getComponentCount());
+    
+    const uint32_t* components = oid.getComponents();
     TEST_ASSERT_EQUAL(1, components[0]);
     TEST_ASSERT_EQUAL(3, components[1]);
     TEST_ASSERT_EQUAL(6, components[2]);
@@ -55,7 +55,8 @@ void test_octet_string_max_length() {
     bool result = decoded.decode(buffer, length, bytesRead);
     
     TEST_ASSERT_TRUE(result);
-    TEST_ASSERT_EQUAL_STRING(maxStr, decoded.getValue());
+    TEST_ASSERT_EQUAL(MAX_STRING_LENGTH - 1, decoded.getLength());
+    TEST_ASSERT_EQUAL_STRING_LEN(maxStr, decoded.getValue(), MAX_STRING_LENGTH - 1);
 }
 
 void test_oid_max_components() {
@@ -76,9 +77,12 @@ void test_oid_max_components() {
     bool result = decoded.decode(buffer, length, bytesRead);
     
     TEST_ASSERT_TRUE(result);
-    TEST_ASSERT_EQUAL(MAX_OID_LENGTH, decoded.getComponentCount());
     
-    const uint32_t* decodedComponents = decoded.getComponents();
+    OID decodedOid;
+    TEST_ASSERT_TRUE(decoded.getValue(decodedOid));
+    TEST_ASSERT_EQUAL(MAX_OID_LENGTH, decodedOid.getComponentCount());
+    
+    const uint32_t* decodedComponents = decodedOid.getComponents();
     for (size_t i = 0; i < MAX_OID_LENGTH; i++) {
         TEST_ASSERT_EQUAL(components[i], decodedComponents[i]);
     }
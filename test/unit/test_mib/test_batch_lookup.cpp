@@ -0,0 +1,131 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "MIB.h"
+
+static constexpr size_t NODE_COUNT = 20;
+
+// "1.3.6.1.4.1.63050.9.<column>"
+static OID column(uint32_t number) {
+    char text[32];
+    snprintf(text, sizeof(text), "1.3.6.1.4.1.63050.9.%lu", static_cast<unsigned long>(number));
+    OID oid;
+    OID::parse(text, oid);
+    return oid;
+}
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void buildMIB(MIB& mib) {
+    // Even columns only, so odd ones fall between nodes
+    for (uint32_t i = 1; i <= NODE_COUNT; i++) {
+        mib.registerNode(column(i * 2), MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+            []() { return ASN1Object(ASN1Object::Type::INTEGER); });
+    }
+}
+
+void test_batch_get_matches_single_lookups() {
+    MIB mib;
+    buildMIB(mib);
+
+    // Out of order, with a repeat and names that are not nodes
+    const uint32_t numbers[] = {40, 3, 2, 18, 18, 99, 7, 22};
+    const size_t count = sizeof(numbers) / sizeof(numbers[0]);
+    OID oids[count];
+    MIB::Lookup lookups[count];
+    for (size_t i = 0; i < count; i++) {
+        oids[i] = column(numbers[i]);
+        lookups[i] = {oids[i].getEncoded(), oids[i].getEncodedLength(), nullptr};
+    }
+    TEST_ASSERT_TRUE(mib.findNodes(lookups, count, false));
+
+    for (size_t i = 0; i < count; i++) {
+        ASN1Object value;
+        bool present = mib.getValue(oids[i], value);
+        TEST_ASSERT_EQUAL(present, lookups[i].node != nullptr);
+        if (present) {
+            TEST_ASSERT_EQUAL(oids[i].getEncodedLength(), lookups[i].node->oidLength);
+            TEST_ASSERT_EQUAL_MEMORY(oids[i].getEncoded(), lookups[i].node->oid,
+                                     lookups[i].node->oidLength);
+            TEST_ASSERT_TRUE(mib.getValue(*lookups[i].node, value));
+        }
+    }
+    TEST_ASSERT_NULL(lookups[1].node);
+    TEST_ASSERT_NOT_NULL(lookups[3].node);
+    TEST_ASSERT_EQUAL_PTR(lookups[3].node, lookups[4].node);
+}
+
+void test_batch_get_next_matches_single_lookups() {
+    MIB mib;
+    buildMIB(mib);
+
+    const uint32_t numbers[] = {39, 1, 40, 2, 41, 17};
+    const size_t count = sizeof(numbers) / sizeof(numbers[0]);
+    OID oids[count];
+    MIB::Lookup lookups[count];
+    for (size_t i = 0; i < count; i++) {
+        oids[i] = column(numbers[i]);
+        lookups[i] = {oids[i].getEncoded(), oids[i].getEncodedLength(), nullptr};
+    }
+    TEST_ASSERT_TRUE(mib.findNodes(lookups, count, true));
+
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* next = nullptr;
+        size_t nextLength = 0;
+        bool found = mib.getNextOID(oids[i].getEncoded(), oids[i].getEncodedLength(), next, nextLength);
+        TEST_ASSERT_EQUAL(found, lookups[i].node != nullptr);
+        if (found) {
+            TEST_ASSERT_EQUAL_PTR(next, lookups[i].node->oid);
+        }
+    }
+
+    // Past the last node
+    TEST_ASSERT_NULL(lookups[2].node);
+    TEST_ASSERT_NULL(lookups[4].node);
+}
+
+void test_batch_limit() {
+    MIB mib;
+    buildMIB(mib);
+
+    OID oid = column(2);
+    MIB::Lookup lookups[MIB::MAX_LOOKUPS + 1];
+    for (size_t i = 0; i <= MIB::MAX_LOOKUPS; i++) {
+        lookups[i] = {oid.getEncoded(), oid.getEncodedLength(), nullptr};
+    }
+    TEST_ASSERT_TRUE(mib.findNodes(lookups, MIB::MAX_LOOKUPS, false));
+    TEST_ASSERT_FALSE(mib.findNodes(lookups, MIB::MAX_LOOKUPS + 1, false));
+    TEST_ASSERT_TRUE(mib.findNodes(lookups, 0, false));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_batch_get_matches_single_lookups);
+    RUN_TEST(test_batch_get_next_matches_single_lookups);
+    RUN_TEST(test_batch_limit);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
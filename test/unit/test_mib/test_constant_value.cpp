@@ -0,0 +1,107 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "BERConstant.h"
+#include "MIB.h"
+
+using namespace ASN1;
+
+// Evaluated entirely by the compiler
+static constexpr BERConstant DESCR = BERConstant::string("Power Monitor");
+static_assert(DESCR.isValid(), "string must fit");
+static_assert(DESCR.size() == 15, "tag, length and 13 octets");
+static_assert(DESCR.data()[0] == OCTET_STRING_TAG && DESCR.data()[1] == 13, "header");
+
+static constexpr BERConstant ENTERPRISE = BERConstant::oid(OID{"1.3.6.1.4.1.63050.1"});
+static constexpr BERConstant LEVEL = BERConstant::integer(-129);
+static constexpr BERConstant TICKS = BERConstant::unsignedValue(TIMETICKS_TAG, 0x80000000u);
+
+static constexpr OID DESCR_OID{"1.3.6.1.4.1.63050.6.1"};
+static constexpr OID LEVEL_OID{"1.3.6.1.4.1.63050.6.2"};
+static constexpr OID DYNAMIC_OID{"1.3.6.1.4.1.63050.6.3"};
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_constant_encoding() {
+    const uint8_t enterprise[] = {0x06, 0x09, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01};
+    TEST_ASSERT_EQUAL(sizeof(enterprise), ENTERPRISE.size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(enterprise, ENTERPRISE.data(), sizeof(enterprise));
+
+    const uint8_t level[] = {0x02, 0x02, 0xFF, 0x7F};
+    TEST_ASSERT_EQUAL(sizeof(level), LEVEL.size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(level, LEVEL.data(), sizeof(level));
+
+    // Leading zero keeps the top bit of an unsigned value
+    const uint8_t ticks[] = {0x43, 0x05, 0x00, 0x80, 0x00, 0x00, 0x00};
+    TEST_ASSERT_EQUAL(sizeof(ticks), TICKS.size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ticks, TICKS.data(), sizeof(ticks));
+
+    TEST_ASSERT_FALSE(BERConstant().isValid());
+}
+
+void test_constant_node_lookup() {
+    MIB mib;
+    TEST_ASSERT_TRUE(mib.registerNode(DESCR_OID, MIB::NodeType::STRING, DESCR));
+    TEST_ASSERT_TRUE(mib.registerNode(LEVEL_OID, MIB::NodeType::INTEGER, LEVEL));
+    TEST_ASSERT_TRUE(mib.registerNode(DYNAMIC_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() {
+            ASN1Object value(ASN1Object::Type::INTEGER);
+            value.setInteger(5);
+            return value;
+        }));
+
+    // The encoded value is the constant itself, not a copy
+    const uint8_t* encoded = nullptr;
+    uint16_t size = 0;
+    TEST_ASSERT_TRUE(mib.getEncodedValue(DESCR_OID.getEncoded(), DESCR_OID.getEncodedLength(),
+                                         encoded, size));
+    TEST_ASSERT_EQUAL_PTR(DESCR.data(), encoded);
+    TEST_ASSERT_EQUAL(DESCR.size(), size);
+    TEST_ASSERT_FALSE(mib.getEncodedValue(DYNAMIC_OID.getEncoded(), DYNAMIC_OID.getEncodedLength(),
+                                          encoded, size));
+
+    // Decoded values refer to the constant's bytes
+    ASN1Object value;
+    TEST_ASSERT_TRUE(mib.getValue(DESCR_OID, value));
+    TEST_ASSERT_EQUAL(ASN1Object::Type::OCTET_STRING, value.getType());
+    TEST_ASSERT_EQUAL(13, value.getStringLength());
+    TEST_ASSERT_EQUAL_PTR(DESCR.data() + 2, value.getString());
+    TEST_ASSERT_TRUE(mib.getValue(LEVEL_OID, value));
+    TEST_ASSERT_EQUAL(-129, value.getInteger());
+
+    // Constant nodes are read-only
+    value.setInteger(1);
+    TEST_ASSERT_FALSE(mib.setValue(LEVEL_OID, value));
+    TEST_ASSERT_TRUE(mib.testValue(LEVEL_OID.getEncoded(), LEVEL_OID.getEncodedLength(), value) ==
+                     MIB::SetError::NOT_WRITABLE);
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_constant_encoding);
+    RUN_TEST(test_constant_node_lookup);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
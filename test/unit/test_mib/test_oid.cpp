@@ -0,0 +1,194 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "OID.h"
+#include "MIB.h"
+
+// Evaluated entirely by the compiler
+static constexpr OID POWER_STATE_OID{"1.3.6.1.4.1.63050.1.1.0"};
+static_assert(POWER_STATE_OID.isValid(), "literal must parse");
+static_assert(POWER_STATE_OID.getComponentCount() == 10, "component count");
+static_assert(POWER_STATE_OID.getEncodedLength() == 11, "encoded length");
+static_assert(POWER_STATE_OID.getEncoded()[0] == 0x2B, "first two arcs packed");
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_oid_literal_encoding() {
+    uint8_t expected[] = {0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01, 0x01, 0x00};
+    TEST_ASSERT_EQUAL(sizeof(expected), POWER_STATE_OID.getEncodedLength());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, POWER_STATE_OID.getEncoded(), sizeof(expected));
+    TEST_ASSERT_EQUAL_UINT32(63050, POWER_STATE_OID.getComponents()[6]);
+}
+
+void test_oid_runtime_parse() {
+    OID parsed;
+    TEST_ASSERT_TRUE(OID::parse("1.3.6.1.4.1.63050.1.1.0", parsed));
+    TEST_ASSERT_TRUE(parsed == POWER_STATE_OID);
+
+    char text[64];
+    TEST_ASSERT_TRUE(parsed.toString(text, sizeof(text)));
+    TEST_ASSERT_EQUAL_STRING("1.3.6.1.4.1.63050.1.1.0", text);
+
+    // Too small a buffer fails instead of truncating
+    TEST_ASSERT_FALSE(parsed.toString(text, 8));
+
+    TEST_ASSERT_FALSE(OID::parse("1..3", parsed));
+    TEST_ASSERT_FALSE(OID::parse("3.1", parsed));
+    TEST_ASSERT_FALSE(OID::parse("1.3.x", parsed));
+    TEST_ASSERT_FALSE(OID::parse("1.3.", parsed));
+    TEST_ASSERT_FALSE(OID::parse("1.3.4294967296", parsed));
+    TEST_ASSERT_FALSE(parsed.isValid());
+}
+
+void test_oid_from_encoded() {
+    OID decoded;
+    TEST_ASSERT_TRUE(OID::fromEncoded(POWER_STATE_OID.getEncoded(),
+                                      POWER_STATE_OID.getEncodedLength(), decoded));
+    TEST_ASSERT_EQUAL(10, decoded.getComponentCount());
+    TEST_ASSERT_EQUAL_UINT32(63050, decoded.getComponents()[6]);
+    TEST_ASSERT_TRUE(decoded == POWER_STATE_OID);
+
+    // Truncated sub-identifier
+    uint8_t truncated[] = {0x2B, 0x06, 0x83};
+    TEST_ASSERT_FALSE(OID::fromEncoded(truncated, sizeof(truncated), decoded));
+
+    // Sub-identifier wider than 32 bits
+    uint8_t overflow[] = {0x2B, 0x90, 0x80, 0x80, 0x80, 0x00};
+    TEST_ASSERT_FALSE(OID::fromEncoded(overflow, sizeof(overflow), decoded));
+}
+
+void test_mib_lookup_by_oid() {
+    static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+    static constexpr OID SYS_OBJECT_ID_OID{"1.3.6.1.2.1.1.2"};
+    static constexpr OID UNKNOWN_OID{"1.3.6.1.2.1.1.999"};
+
+    MIB mib;
+    mib.initialize();
+
+    ASN1Object value;
+    TEST_ASSERT_TRUE(mib.getValue(SYS_DESCR_OID, value));
+    TEST_ASSERT_EQUAL(ASN1Object::Type::OCTET_STRING, value.getType());
+    TEST_ASSERT_FALSE(mib.getValue(UNKNOWN_OID, value));
+
+    OID next;
+    TEST_ASSERT_TRUE(mib.getNextOID(SYS_DESCR_OID, next));
+    TEST_ASSERT_TRUE(next == SYS_OBJECT_ID_OID);
+
+    // Text lookups still work and agree with the encoded ones
+    TEST_ASSERT_TRUE(mib.getValue("1.3.6.1.2.1.1.1", value));
+}
+
+void test_mib_order_across_subidentifier_lengths() {
+    static constexpr OID SHORT_OID{"1.3.6.1.4.1.127"};
+    static constexpr OID LONG_OID{"1.3.6.1.4.1.128"};
+
+    MIB mib;
+    TEST_ASSERT_TRUE(mib.registerNode(LONG_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return ASN1Object(ASN1Object::Type::INTEGER); }));
+    TEST_ASSERT_TRUE(mib.registerNode(SHORT_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return ASN1Object(ASN1Object::Type::INTEGER); }));
+
+    // 127 encodes as 0x7F and 128 as 0x81 0x00, yet 127 must come first
+    OID first;
+    OID second;
+    TEST_ASSERT_TRUE(mib.getNextOID(OID(), first));
+    TEST_ASSERT_TRUE(first == SHORT_OID);
+    TEST_ASSERT_TRUE(mib.getNextOID(first, second));
+    TEST_ASSERT_TRUE(second == LONG_OID);
+    TEST_ASSERT_FALSE(mib.getNextOID(second, first));
+}
+
+static ASN1Object integerValue() {
+    return ASN1Object(ASN1Object::Type::INTEGER);
+}
+
+void test_mib_walk_order_matches_numeric_order() {
+    // Registered out of order. 16383 (0xFF 0x7F) must sort before 16384
+    // (0x81 0x80 0x00) although its first octet is larger.
+    static constexpr OID SORTED[] = {
+        OID{"1.3.6.1.4.1.5"},
+        OID{"1.3.6.1.4.1.5.1"},
+        OID{"1.3.6.1.4.1.127"},
+        OID{"1.3.6.1.4.1.128"},
+        OID{"1.3.6.1.4.1.16383"},
+        OID{"1.3.6.1.4.1.16383.2"},
+        OID{"1.3.6.1.4.1.16384"},
+        OID{"1.3.6.1.4.1.63050.1"},
+        OID{"1.3.6.2"},
+    };
+    static const size_t COUNT = sizeof(SORTED) / sizeof(SORTED[0]);
+    static const size_t ORDER[] = {6, 2, 8, 0, 4, 7, 1, 5, 3};
+
+    MIB mib;
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT_TRUE(mib.registerNode(SORTED[ORDER[i]], MIB::NodeType::INTEGER,
+                                          MIB::Access::READ_ONLY, integerValue));
+    }
+
+    OID current;
+    for (size_t i = 0; i < COUNT; i++) {
+        OID next;
+        TEST_ASSERT_TRUE(mib.getNextOID(current, next));
+        TEST_ASSERT_TRUE(next == SORTED[i]);
+        current = next;
+    }
+    TEST_ASSERT_FALSE(mib.getNextOID(current, current));
+}
+
+void test_mib_lookup_from_packet_bytes() {
+    MIB mib;
+    mib.initialize();
+
+    // Content octets of sysName as they sit in a request
+    const uint8_t sysName[] = {0x2B, 0x06, 0x01, 0x02, 0x01, 0x01, 0x05};
+    ASN1Object value;
+    TEST_ASSERT_TRUE(mib.getValue(sysName, sizeof(sysName), value));
+    TEST_ASSERT_EQUAL_STRING_LEN("PowerMonitor", value.getString(), value.getStringLength());
+
+    // A prefix is not a match, but GetNext moves past it
+    const uint8_t system[] = {0x2B, 0x06, 0x01, 0x02, 0x01, 0x01};
+    TEST_ASSERT_FALSE(mib.getValue(system, sizeof(system), value));
+
+    const uint8_t* next;
+    size_t nextLength;
+    TEST_ASSERT_TRUE(mib.getNextOID(system, sizeof(system), next, nextLength));
+    TEST_ASSERT_EQUAL(7, nextLength);
+    TEST_ASSERT_EQUAL_HEX8(0x01, next[6]);
+
+    TEST_ASSERT_TRUE(mib.getNextOID(sysName, sizeof(sysName), next, nextLength));
+    TEST_ASSERT_EQUAL_HEX8(0x06, next[6]);
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_oid_literal_encoding);
+    RUN_TEST(test_oid_runtime_parse);
+    RUN_TEST(test_oid_from_encoded);
+    RUN_TEST(test_mib_lookup_by_oid);
+    RUN_TEST(test_mib_order_across_subidentifier_lengths);
+    RUN_TEST(test_mib_walk_order_matches_numeric_order);
+    RUN_TEST(test_mib_lookup_from_packet_bytes);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
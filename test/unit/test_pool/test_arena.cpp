@@ -0,0 +1,223 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include "Arena.h"
+#include "MIB.h"
+#include "SNMPMessage.h"
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+void test_arena_allocate_and_reset() {
+    alignas(8) static uint8_t storage[64];
+    Arena arena(storage, sizeof(storage));
+    TEST_ASSERT_EQUAL(64, arena.capacity());
+
+    uint8_t* bytes = arena.allocate<uint8_t>(3);
+    uint32_t* words = arena.allocate<uint32_t>(2);
+    TEST_ASSERT_TRUE(bytes == storage);
+    TEST_ASSERT_NOT_NULL(words);
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(words) % alignof(uint32_t));
+    TEST_ASSERT_EQUAL(12, arena.used());
+
+    // Too large leaves the arena as it was
+    TEST_ASSERT_NULL(arena.allocate<uint8_t>(53));
+    TEST_ASSERT_EQUAL(12, arena.used());
+    TEST_ASSERT_NOT_NULL(arena.allocate<uint8_t>(52));
+    TEST_ASSERT_NULL(arena.allocate<uint8_t>(1));
+
+    arena.reset();
+    TEST_ASSERT_EQUAL(0, arena.used());
+    TEST_ASSERT_EQUAL(64, arena.peak());
+    TEST_ASSERT_TRUE(arena.allocate<uint8_t>(1) == storage);
+}
+
+void test_arena_grow() {
+    alignas(8) static uint8_t storage[64];
+    Arena arena(storage, sizeof(storage));
+
+    // The newest block grows where it is
+    uint16_t* items = arena.grow<uint16_t>(nullptr, 0, 2);
+    items[0] = 1;
+    items[1] = 2;
+    uint16_t* grown = arena.grow(items, 2, 8);
+    TEST_ASSERT_TRUE(grown == items);
+    TEST_ASSERT_EQUAL(16, arena.used());
+
+    // Behind another block it moves, keeping its contents
+    arena.allocate<uint8_t>(1);
+    grown = arena.grow(items, 8, 10);
+    TEST_ASSERT_NOT_NULL(grown);
+    TEST_ASSERT_TRUE(grown != items);
+    TEST_ASSERT_EQUAL(1, grown[0]);
+    TEST_ASSERT_EQUAL(2, grown[1]);
+
+    // Failure leaves the block in place
+    TEST_ASSERT_NULL(arena.grow(grown, 10, 100));
+    TEST_ASSERT_EQUAL(2, grown[1]);
+
+    // Only the newest block gives its end back
+    uint8_t* newest = arena.allocate<uint8_t>(8);
+    size_t used = arena.used();
+    arena.shrink(grown, 10, 2);
+    TEST_ASSERT_EQUAL(used, arena.used());
+    arena.shrink(newest, 8, 3);
+    TEST_ASSERT_EQUAL(used - 5, arena.used());
+}
+
+static constexpr size_t LARGE_COUNT = 40;
+
+// "1.3.6.1.4.1.63050.9.<column>"
+static OID column(uint32_t number) {
+    char text[32];
+    snprintf(text, sizeof(text), "1.3.6.1.4.1.63050.9.%lu", static_cast<unsigned long>(number));
+    OID oid;
+    OID::parse(text, oid);
+    return oid;
+}
+
+static size_t buildRequest(uint8_t* buffer, uint16_t size, size_t count) {
+    SNMPMessage message;
+    message.setVersion(SNMPMessage::VERSION_2C);
+    message.setCommunity("public");
+    message.setRequestID(23);
+    for (size_t i = 0; i < count; i++) {
+        message.addVarBind(column(i + 1), ASN1Object(ASN1Object::Type::NULL_TYPE));
+    }
+    return message.encode(buffer, size);
+}
+
+void test_message_sized_by_arena() {
+    MIB mib;
+    for (uint32_t i = 1; i <= LARGE_COUNT; i++) {
+        mib.registerNode(column(i), MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+            []() {
+                ASN1Object value(ASN1Object::Type::INTEGER);
+                value.setInteger(5);
+                return value;
+            });
+    }
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    size_t size = buildRequest(buffer, sizeof(buffer), LARGE_COUNT);
+    TEST_ASSERT_TRUE(size > 0);
+
+    // More varbinds than MAX_VARBINDS, in one request's arena
+    alignas(8) static uint8_t storage[8192];
+    Arena arena(storage, sizeof(storage));
+    SNMPMessage request(arena);
+    SNMPMessage response(arena);
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+    TEST_ASSERT_EQUAL(LARGE_COUNT, request.getVarBindViewCount());
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(LARGE_COUNT, response.getVarBindCount());
+    TEST_ASSERT_EQUAL(5, response.getVarBinds()[LARGE_COUNT - 1].value.getInteger());
+
+    // A single-varbind GET uses a fraction of that
+    request.clear();
+    response.clear();
+    arena.reset();
+    size = buildRequest(buffer, sizeof(buffer), 1);
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, response.getVarBindCount());
+    TEST_ASSERT_TRUE(arena.used() < 256);
+}
+
+void test_full_arena_answers_too_big() {
+    MIB mib;
+    mib.initialize();
+    static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+
+    uint8_t buffer[256];
+    SNMPMessage message;
+    message.setVersion(SNMPMessage::VERSION_2C);
+    message.setCommunity("public");
+    for (size_t i = 0; i < 4; i++) {
+        message.addVarBind(SYS_DESCR_OID, ASN1Object(ASN1Object::Type::NULL_TYPE));
+    }
+    size_t size = message.encode(buffer, sizeof(buffer));
+
+    // Room for the request views, not for the answers
+    alignas(8) static uint8_t storage[sizeof(SNMPMessage::VarBindView) * 4 +
+                                      sizeof(MIB::Lookup) * 4 + 16];
+    Arena arena(storage, sizeof(storage));
+    SNMPMessage request(arena);
+    SNMPMessage response(arena);
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+    TEST_ASSERT_EQUAL(4, request.getVarBindViewCount());
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, response.getErrorStatus());     // tooBig
+    TEST_ASSERT_EQUAL(0, response.getVarBindCount());
+}
+
+void test_truncated_request_answers_too_big() {
+    MIB mib;
+    mib.initialize();
+    static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+
+    uint8_t buffer[256];
+    SNMPMessage message;
+    message.setVersion(SNMPMessage::VERSION_2C);
+    message.setCommunity("public");
+    for (size_t i = 0; i < 4; i++) {
+        message.addVarBind(SYS_DESCR_OID, ASN1Object(ASN1Object::Type::NULL_TYPE));
+    }
+    size_t size = message.encode(buffer, sizeof(buffer));
+
+    // Room for two of the four request views: the rest is not dropped
+    // unnoticed
+    alignas(8) static uint8_t storage[sizeof(SNMPMessage::VarBindView) * 2];
+    Arena arena(storage, sizeof(storage));
+    SNMPMessage request(arena);
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+    TEST_ASSERT_TRUE(request.isTruncated());
+    TEST_ASSERT_EQUAL(2, request.getVarBindViewCount());
+
+    SNMPMessage response;
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, response.getErrorStatus());     // tooBig
+    TEST_ASSERT_EQUAL(0, response.getErrorIndex());
+    TEST_ASSERT_EQUAL(0, response.getVarBindCount());
+
+    // Decoded again with room for all, it is whole
+    alignas(8) static uint8_t larger[sizeof(SNMPMessage::VarBindView) * 4];
+    Arena roomy(larger, sizeof(larger));
+    SNMPMessage whole(roomy);
+    TEST_ASSERT_TRUE(whole.decode(buffer, size));
+    TEST_ASSERT_FALSE(whole.isTruncated());
+    TEST_ASSERT_EQUAL(4, whole.getVarBindViewCount());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_arena_allocate_and_reset);
+    RUN_TEST(test_arena_grow);
+    RUN_TEST(test_message_sized_by_arena);
+    RUN_TEST(test_full_arena_answers_too_big);
+    RUN_TEST(test_truncated_request_answers_too_big);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
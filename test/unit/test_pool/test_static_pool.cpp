@@ -0,0 +1,83 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "StaticPool.h"
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+struct Slot {
+    uint8_t data[100];
+};
+
+void test_pool_acquire_until_exhausted() {
+    static StaticPool<Slot, 3> pool;
+    TEST_ASSERT_EQUAL(3, pool.capacity());
+    TEST_ASSERT_EQUAL(3, pool.available());
+
+    Slot* a = pool.acquire();
+    Slot* b = pool.acquire();
+    Slot* c = pool.acquire();
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_TRUE(a != b && b != c && a != c);
+    TEST_ASSERT_EQUAL(0, pool.available());
+    TEST_ASSERT_NULL(pool.acquire());
+
+    // The slot released last is handed out next
+    TEST_ASSERT_TRUE(pool.release(b));
+    TEST_ASSERT_EQUAL(1, pool.available());
+    TEST_ASSERT_TRUE(pool.acquire() == b);
+
+    TEST_ASSERT_TRUE(pool.release(a));
+    TEST_ASSERT_TRUE(pool.release(b));
+    TEST_ASSERT_TRUE(pool.release(c));
+    TEST_ASSERT_EQUAL(3, pool.available());
+}
+
+void test_pool_rejects_bad_release() {
+    static StaticPool<Slot, 2> pool;
+    Slot outside;
+
+    Slot* slot = pool.acquire();
+    TEST_ASSERT_FALSE(pool.release(nullptr));
+    TEST_ASSERT_FALSE(pool.release(&outside));
+    TEST_ASSERT_TRUE(pool.release(slot));
+
+    // A second release would put the slot on the free list twice
+    TEST_ASSERT_FALSE(pool.release(slot));
+    TEST_ASSERT_EQUAL(2, pool.available());
+    Slot* first = pool.acquire();
+    Slot* second = pool.acquire();
+    TEST_ASSERT_TRUE(first != second);
+    TEST_ASSERT_NULL(pool.acquire());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pool_acquire_until_exhausted);
+    RUN_TEST(test_pool_rejects_bad_release);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
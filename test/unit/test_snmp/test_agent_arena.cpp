@@ -0,0 +1,194 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPAgent.h"
+#include "SNMPMessage.h"
+#include "MIB.h"
+
+static constexpr OID SCALAR_OID{"1.3.6.1.4.1.63050.8.1.0"};
+
+// Smallest varbind: SEQUENCE { OID 1.3, NULL }
+static const uint8_t MINIMAL_VARBIND[] = {0x30, 0x05, 0x06, 0x01, 0x2B, 0x05, 0x00};
+
+// Message, PDU and varbind list headers, each with a two-octet length
+static constexpr uint16_t HEADERS_SIZE = 32;
+
+static SNMPAgent::Context context;
+
+// Responses are decoded apart from the agent's arena
+alignas(8) static uint8_t decodeStorage[SNMPAgent::ARENA_SIZE];
+static Arena decodeArena(decodeStorage, sizeof(decodeStorage));
+
+void setUp(void) {
+    context.reset();
+    decodeArena.reset();
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static ASN1Object integer(int32_t number) {
+    ASN1Object value(ASN1Object::Type::INTEGER);
+    value.setInteger(number);
+    return value;
+}
+
+static void putHeader(uint8_t*& out, uint8_t tag, uint16_t length) {
+    *out++ = tag;
+    *out++ = 0x82;
+    *out++ = static_cast<uint8_t>(length >> 8);
+    *out++ = static_cast<uint8_t>(length);
+}
+
+// Request with count copies of varbind, community "public"; varbinds
+// must take more than 255 bytes. GetBulk asks for one repetition.
+static uint16_t buildRequest(SNMPMessage::PDUType type, uint8_t version,
+                             const uint8_t* varbind, uint8_t varbindSize, size_t count,
+                             uint8_t* buffer) {
+    static const uint8_t COMMUNITY[] = {0x04, 0x06, 'p', 'u', 'b', 'l', 'i', 'c'};
+    static const uint8_t PDU_FIELDS[] = {0x02, 0x01, 0x2A, 0x02, 0x01, 0x00, 0x02, 0x01, 0x00};
+    uint16_t list = varbindSize * count;
+    uint16_t pdu = sizeof(PDU_FIELDS) + 4 + list;
+    uint8_t* out = buffer;
+    putHeader(out, 0x30, 3 + sizeof(COMMUNITY) + 4 + pdu);
+    *out++ = 0x02;
+    *out++ = 0x01;
+    *out++ = version;
+    memcpy(out, COMMUNITY, sizeof(COMMUNITY));
+    out += sizeof(COMMUNITY);
+    putHeader(out, static_cast<uint8_t>(type), pdu);
+    memcpy(out, PDU_FIELDS, sizeof(PDU_FIELDS));
+    out += sizeof(PDU_FIELDS);
+    if (type == SNMPMessage::PDUType::GET_BULK_REQUEST) {
+        out[-1] = 1;    // max-repetitions
+    }
+    putHeader(out, 0x30, list);
+    for (size_t i = 0; i < count; i++) {
+        memcpy(out, varbind, varbindSize);
+        out += varbindSize;
+    }
+    return out - buffer;
+}
+
+// Through SNMPAgent::respond and back through the decoder
+static bool respond(MIB& mib, uint16_t size, SNMPMessage& decoded) {
+    const uint8_t* response = nullptr;
+    uint16_t responseSize = SNMPAgent::respond(context, size, mib, "", response);
+    static uint8_t copy[SNMPAgent::RECEIVE_BUFFER_SIZE];
+    if (responseSize == 0) {
+        return false;
+    }
+    memcpy(copy, response, responseSize);
+    return decoded.decode(copy, responseSize);
+}
+
+void test_arena_holds_the_largest_request() {
+    TEST_ASSERT_TRUE(SNMPMessage::MAX_REQUEST_VARBINDS * sizeof(MINIMAL_VARBIND) <=
+                     SNMPMessage::MAX_PACKET_SIZE);
+    TEST_ASSERT_TRUE(SNMPAgent::requestArena().capacity() >=
+                     SNMPMessage::MAX_REQUEST_VARBINDS * SNMPAgent::ARENA_VARBIND_SIZE);
+}
+
+void test_mtu_sized_get_is_answered_in_full() {
+    MIB mib;
+    size_t count = (SNMPMessage::MAX_PACKET_SIZE - HEADERS_SIZE) / sizeof(MINIMAL_VARBIND);
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, SNMPMessage::VERSION_2C,
+                                 MINIMAL_VARBIND, sizeof(MINIMAL_VARBIND), count, context.buffer);
+    TEST_ASSERT_TRUE(size <= SNMPMessage::MAX_PACKET_SIZE);
+    TEST_ASSERT_TRUE(size > SNMPMessage::MAX_PACKET_SIZE - sizeof(MINIMAL_VARBIND));
+
+    // Each unknown name gets an exception as long as its NULL
+    SNMPMessage decoded(decodeArena);
+    TEST_ASSERT_TRUE(respond(mib, size, decoded));
+    TEST_ASSERT_EQUAL(0, decoded.getErrorStatus());
+    TEST_ASSERT_EQUAL(count, decoded.getVarBindViewCount());
+    TEST_ASSERT_EQUAL(0x80, decoded.getVarBindViews()[count - 1].value.tag);
+    TEST_ASSERT_TRUE(SNMPAgent::requestArena().peak() <= SNMPAgent::ARENA_SIZE);
+}
+
+void test_mtu_sized_getnext_answers_too_big() {
+    MIB mib;
+    mib.registerNode(SCALAR_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(1); });
+    size_t count = (SNMPMessage::MAX_PACKET_SIZE - HEADERS_SIZE) / sizeof(MINIMAL_VARBIND);
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_NEXT_REQUEST, SNMPMessage::VERSION_2C,
+                                 MINIMAL_VARBIND, sizeof(MINIMAL_VARBIND), count, context.buffer);
+
+    // Every successor is the scalar, far longer than the name asked for
+    SNMPMessage decoded(decodeArena);
+    TEST_ASSERT_TRUE(respond(mib, size, decoded));
+    TEST_ASSERT_EQUAL(1, decoded.getErrorStatus());
+    TEST_ASSERT_EQUAL(0, decoded.getVarBindViewCount());
+}
+
+void test_mtu_sized_get_too_big_to_answer() {
+    MIB mib;
+    mib.registerNode(SCALAR_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(100000); });
+
+    // SEQUENCE { OID, NULL }; each answer is longer than its request
+    uint8_t varbind[4 + SCALAR_OID.getEncodedLength()];
+    varbind[0] = 0x30;
+    varbind[1] = sizeof(varbind) - 2;
+    varbind[2] = 0x06;
+    varbind[3] = SCALAR_OID.getEncodedLength();
+    memcpy(varbind + 4, SCALAR_OID.getEncoded(), SCALAR_OID.getEncodedLength());
+    uint8_t full[sizeof(varbind) + 2];
+    memcpy(full, varbind, sizeof(varbind));
+    full[1] += 2;
+    full[sizeof(varbind)] = 0x05;
+    full[sizeof(varbind) + 1] = 0x00;
+
+    size_t count = (SNMPMessage::MAX_PACKET_SIZE - HEADERS_SIZE) / sizeof(full);
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, SNMPMessage::VERSION_1,
+                                 full, sizeof(full), count, context.buffer);
+
+    SNMPMessage decoded(decodeArena);
+    TEST_ASSERT_TRUE(respond(mib, size, decoded));
+    TEST_ASSERT_EQUAL(1, decoded.getErrorStatus());
+    TEST_ASSERT_EQUAL(0, decoded.getErrorIndex());
+    TEST_ASSERT_EQUAL(0, decoded.getVarBindViewCount());
+}
+
+void test_mtu_sized_get_bulk_is_walked() {
+    MIB mib;
+    mib.registerNode(SCALAR_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(1); });
+    size_t count = (SNMPMessage::MAX_PACKET_SIZE - HEADERS_SIZE) / sizeof(MINIMAL_VARBIND);
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_BULK_REQUEST, SNMPMessage::VERSION_2C,
+                                 MINIMAL_VARBIND, sizeof(MINIMAL_VARBIND), count, context.buffer);
+
+    // As many rows as fit; the walk itself has room for every cursor
+    SNMPMessage decoded(decodeArena);
+    TEST_ASSERT_TRUE(respond(mib, size, decoded));
+    TEST_ASSERT_EQUAL(0, decoded.getErrorStatus());
+    TEST_ASSERT_TRUE(decoded.getVarBindViewCount() > 0);
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_arena_holds_the_largest_request);
+    RUN_TEST(test_mtu_sized_get_is_answered_in_full);
+    RUN_TEST(test_mtu_sized_getnext_answers_too_big);
+    RUN_TEST(test_mtu_sized_get_too_big_to_answer);
+    RUN_TEST(test_mtu_sized_get_bulk_is_walked);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,198 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "SNMPBulkResponder.h"
+#include "ASN1Types.h"
+#include "MIB.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static constexpr OID SYSTEM_OID{"1.3.6.1.2.1.1"};
+static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+static constexpr OID SYS_OBJECT_ID_OID{"1.3.6.1.2.1.1.2"};
+static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+static constexpr OID SYS_LOCATION_OID{"1.3.6.1.2.1.1.6"};
+
+static uint16_t buildBulkRequest(uint8_t version, int32_t nonRepeaters, int32_t maxRepetitions,
+                                 const OID* oids, size_t count, uint8_t* buffer, uint16_t capacity) {
+    SNMPMessage message;
+    ASN1Object null;
+    message.setVersion(version);
+    message.setCommunity("public");
+    message.setPDUType(SNMPMessage::PDUType::GET_BULK_REQUEST);
+    message.setRequestID(0x4242);
+    message.setErrorStatus(nonRepeaters);
+    message.setErrorIndex(maxRepetitions);
+    for (size_t i = 0; i < count; i++) {
+        message.addVarBind(oids[i], null);
+    }
+    return message.encode(buffer, capacity);
+}
+
+static void checkName(const OID& expected, const BERView& oid) {
+    TEST_ASSERT_EQUAL(expected.getEncodedLength(), oid.length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected.getEncoded(), oid.data, oid.length);
+}
+
+void test_bulk_walks_whole_mib() {
+    MIB mib;
+    mib.initialize();
+
+    // The response is encoded over the request it came from
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const OID start[] = {SYSTEM_OID};
+    uint16_t size = buildBulkRequest(SNMPMessage::VERSION_2C, 0, 50, start, 1, buffer, sizeof(buffer));
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+
+    const uint8_t* output = nullptr;
+    uint16_t outputSize = SNMPBulkResponder::respond(request, mib, buffer, sizeof(buffer), output);
+    TEST_ASSERT_TRUE(outputSize > 0);
+
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(response.decode(output, outputSize));
+    TEST_ASSERT_EQUAL(SNMPMessage::VERSION_2C, response.getVersion());
+    TEST_ASSERT_EQUAL(0xA2, static_cast<uint8_t>(response.getPDUType()));
+    TEST_ASSERT_EQUAL(0x4242, response.getRequestID());
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(6, response.getCommunityLength());
+    TEST_ASSERT_EQUAL(0, memcmp(response.getCommunity(), "public", 6));
+
+    // Six system nodes in order, then the walk ends at endOfMibView
+    TEST_ASSERT_EQUAL(7, response.getVarBindViewCount());
+    const SNMPMessage::VarBindView* varbinds = response.getVarBindViews();
+    checkName(SYS_DESCR_OID, varbinds[0].oid);
+    checkName(SYS_LOCATION_OID, varbinds[5].oid);
+    TEST_ASSERT_EQUAL(OCTET_STRING_TAG, varbinds[0].value.tag);
+    checkName(SYS_LOCATION_OID, varbinds[6].oid);
+    TEST_ASSERT_EQUAL(END_OF_MIB_VIEW_TAG, varbinds[6].value.tag);
+    TEST_ASSERT_EQUAL(0, varbinds[6].value.length);
+}
+
+void test_bulk_non_repeaters() {
+    MIB mib;
+    mib.initialize();
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const OID oids[] = {SYS_DESCR_OID, SYS_NAME_OID};
+    uint16_t size = buildBulkRequest(SNMPMessage::VERSION_2C, 1, 3, oids, 2, buffer, sizeof(buffer));
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+
+    const uint8_t* output = nullptr;
+    uint16_t outputSize = SNMPBulkResponder::respond(request, mib, buffer, sizeof(buffer), output);
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(response.decode(output, outputSize));
+
+    // One successor of sysDescr, then sysName repeated until the end
+    TEST_ASSERT_EQUAL(3, response.getVarBindViewCount());
+    const SNMPMessage::VarBindView* varbinds = response.getVarBindViews();
+    checkName(SYS_OBJECT_ID_OID, varbinds[0].oid);
+    checkName(SYS_LOCATION_OID, varbinds[1].oid);
+    checkName(SYS_LOCATION_OID, varbinds[2].oid);
+    TEST_ASSERT_EQUAL(END_OF_MIB_VIEW_TAG, varbinds[2].value.tag);
+}
+
+static const char tableText[40] = "forty bytes of table cell text.........";
+
+static ASN1Object getTableValue() {
+    ASN1Object value(ASN1Object::Type::OCTET_STRING);
+    value.setStringRef(tableText, sizeof(tableText));
+    return value;
+}
+
+void test_bulk_stops_at_byte_budget() {
+    MIB mib;
+    uint32_t components[] = {1, 3, 6, 1, 4, 1, 63050, 5, 0};
+    for (uint32_t i = 1; i <= 60; i++) {
+        OID oid;
+        components[8] = i;
+        TEST_ASSERT_TRUE(OID::fromComponents(components, 9, oid));
+        TEST_ASSERT_TRUE(mib.registerNode(oid, MIB::NodeType::STRING,
+                                          MIB::Access::READ_ONLY, getTableValue));
+    }
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const OID start[] = {OID("1.3.6.1.4.1.63050.5")};
+    uint16_t size = buildBulkRequest(SNMPMessage::VERSION_2C, 0, 100, start, 1, buffer, sizeof(buffer));
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+
+    const uint8_t* output = nullptr;
+    uint16_t outputSize = SNMPBulkResponder::respond(request, mib, buffer, sizeof(buffer), output);
+    TEST_ASSERT_TRUE(outputSize <= SNMPMessage::MAX_PACKET_SIZE);
+
+    // Count every varbind; the budget, not MAX_VARBINDS, set the limit
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(response.decode(output, outputSize));
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    BERReader packet(output, outputSize);
+    BERView message, field, list, varbind;
+    TEST_ASSERT_TRUE(packet.read(SEQUENCE_TAG, message));
+    BERReader fields(message);
+    TEST_ASSERT_TRUE(fields.read(field) && fields.read(field) && fields.read(field));
+    BERReader pdu(field);
+    TEST_ASSERT_TRUE(pdu.read(field) && pdu.read(field) && pdu.read(field));
+    TEST_ASSERT_TRUE(pdu.read(SEQUENCE_TAG, list));
+
+    size_t count = 0;
+    BERReader entries(list);
+    while (entries.read(SEQUENCE_TAG, varbind)) {
+        count++;
+    }
+    TEST_ASSERT_TRUE(entries.atEnd());
+    TEST_ASSERT_TRUE(count > SNMPMessage::MAX_VARBINDS);
+    TEST_ASSERT_TRUE(count < 60);
+
+    // Another varbind would not have fitted
+    TEST_ASSERT_TRUE(outputSize + varbind.length + 2 > SNMPMessage::MAX_PACKET_SIZE);
+}
+
+void test_bulk_requires_v2c() {
+    MIB mib;
+    mib.initialize();
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const OID start[] = {SYSTEM_OID};
+    uint16_t size = buildBulkRequest(SNMPMessage::VERSION_1, 0, 10, start, 1, buffer, sizeof(buffer));
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+
+    const uint8_t* output = nullptr;
+    TEST_ASSERT_EQUAL(0, SNMPBulkResponder::respond(request, mib, buffer, sizeof(buffer), output));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bulk_walks_whole_mib);
+    RUN_TEST(test_bulk_non_repeaters);
+    RUN_TEST(test_bulk_stops_at_byte_budget);
+    RUN_TEST(test_bulk_requires_v2c);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
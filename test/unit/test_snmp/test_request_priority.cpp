@@ -0,0 +1,172 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "SNMPMessage.h"
+#include "FairQueue.h"
+#include "RequestClassifier.h"
+#include "snmp_requests.h"
+
+using Priority = RequestClassifier::Priority;
+
+static constexpr OID POWER_OID{"1.3.6.1.4.1.63050.1.1.0"};
+static constexpr uint32_t PROBE_IP = 0x0A000001;
+static constexpr uint32_t WALKER_IP = 0x0A000002;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static Priority classify(RequestClassifier& classifier, SNMPMessage::PDUType type,
+                         size_t varbinds, uint32_t remoteIP, uint32_t now) {
+    const OID oids[] = {POWER_OID, POWER_OID, POWER_OID, POWER_OID, POWER_OID, POWER_OID};
+    uint8_t buffer[512];
+    uint16_t size = buildRequest(type, 24, oids, varbinds, buffer, sizeof(buffer),
+                                 SNMPMessage::VERSION_2C);
+    return classifier.classify(buffer, size, remoteIP, now);
+}
+
+void test_classify_by_pdu_and_varbinds() {
+    RequestClassifier classifier;
+    using Type = SNMPMessage::PDUType;
+
+    TEST_ASSERT_EQUAL(Priority::HIGH, classify(classifier, Type::GET_REQUEST, 1, PROBE_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::HIGH, classify(classifier, Type::GET_REQUEST,
+                                               RequestClassifier::PROBE_VARBINDS, PROBE_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::NORMAL, classify(classifier, Type::GET_REQUEST,
+                                                 RequestClassifier::PROBE_VARBINDS + 1, PROBE_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::NORMAL, classify(classifier, Type::SET_REQUEST, 1, PROBE_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::HIGH, classify(classifier, Type::GET_RESPONSE, 1, PROBE_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::LOW, classify(classifier, Type::GET_BULK_REQUEST, 1, WALKER_IP, 0));
+
+    // Not SNMP
+    const uint8_t garbage[] = {0x30, 0x03, 0x02, 0x01};
+    TEST_ASSERT_EQUAL(Priority::LOW, classifier.classify(garbage, sizeof(garbage), PROBE_IP, 0));
+}
+
+void test_walk_demotes_get_next() {
+    RequestClassifier classifier;
+    using Type = SNMPMessage::PDUType;
+
+    // A single GetNext is not a walk; the next one within the window is
+    TEST_ASSERT_EQUAL(Priority::NORMAL, classify(classifier, Type::GET_NEXT_REQUEST, 1, WALKER_IP, 0));
+    TEST_ASSERT_EQUAL(Priority::LOW, classify(classifier, Type::GET_NEXT_REQUEST, 1, WALKER_IP, 100));
+    TEST_ASSERT_EQUAL(Priority::NORMAL, classify(classifier, Type::GET_NEXT_REQUEST, 1, PROBE_IP, 100));
+
+    // Gets from a walking client are still probes
+    TEST_ASSERT_EQUAL(Priority::HIGH, classify(classifier, Type::GET_REQUEST, 1, WALKER_IP, 200));
+
+    // The walk is over after a quiet window
+    uint32_t later = 200 + RequestClassifier::WALK_WINDOW_MS;
+    TEST_ASSERT_EQUAL(Priority::NORMAL, classify(classifier, Type::GET_NEXT_REQUEST, 1, WALKER_IP, later));
+}
+
+void test_queue_serves_highest_class_first() {
+    FairQueue<int, 3, 4> queue;
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_TRUE(queue.push(20, 2, PROBE_IP));
+    TEST_ASSERT_TRUE(queue.push(21, 2, PROBE_IP));
+    TEST_ASSERT_TRUE(queue.push(10, 1, WALKER_IP));
+    TEST_ASSERT_FALSE(queue.push(1, 3, WALKER_IP));
+    TEST_ASSERT_TRUE(queue.push(0, 0, WALKER_IP));
+    TEST_ASSERT_FALSE(queue.push(30, 2, 0x0A000003));     // Full
+
+    int item = -1;
+    TEST_ASSERT_TRUE(queue.pop(item));
+    TEST_ASSERT_EQUAL(0, item);
+    TEST_ASSERT_TRUE(queue.pop(item));
+    TEST_ASSERT_EQUAL(10, item);
+    TEST_ASSERT_TRUE(queue.pop(item));
+    TEST_ASSERT_EQUAL(20, item);
+    TEST_ASSERT_TRUE(queue.pop(item));
+    TEST_ASSERT_EQUAL(21, item);
+    TEST_ASSERT_FALSE(queue.pop(item));
+    TEST_ASSERT_EQUAL(2, queue.getRejected());
+}
+
+void test_queue_does_not_starve_low_class() {
+    using Queue = FairQueue<int, 2, 8>;
+    Queue queue;
+    queue.push(100, 1, WALKER_IP);
+
+    // Urgent work keeps arriving; the waiting item still gets its turn
+    int served = 0;
+    int item = -1;
+    for (int i = 0; i < 8; i++) {
+        queue.push(i, 0, PROBE_IP);
+        TEST_ASSERT_TRUE(queue.pop(item));
+        if (item == 100) {
+            break;
+        }
+        served++;
+    }
+    TEST_ASSERT_EQUAL(100, item);
+    TEST_ASSERT_EQUAL(Queue::MAX_SKIPS, served);
+}
+
+void test_clients_share_processing_time() {
+    FairQueue<int, 1, 8> queue(100);
+
+    // A's requests cost three times B's
+    const uint32_t A = 0x0A00000A;
+    const uint32_t B = 0x0A00000B;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(queue.push(1, 0, A));
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(queue.push(2, 0, B));
+    }
+
+    const int expected[] = {1, 2, 2, 2, 1, 1};
+    for (int i = 0; i < 6; i++) {
+        int item = 0;
+        TEST_ASSERT_TRUE(queue.pop(item));
+        TEST_ASSERT_EQUAL(expected[i], item);
+        queue.charge(item == 1 ? 300 : 100);
+    }
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_one_client_cannot_fill_queue() {
+    using Queue = FairQueue<int, 1, 4>;
+    Queue queue;
+    for (int i = 0; i < Queue::CLIENT_LIMIT; i++) {
+        TEST_ASSERT_TRUE(queue.push(i, 0, WALKER_IP));
+    }
+    TEST_ASSERT_FALSE(queue.push(9, 0, WALKER_IP));
+    TEST_ASSERT_EQUAL(1, queue.getRejected());
+
+    // The slot left is another client's
+    TEST_ASSERT_TRUE(queue.push(7, 0, PROBE_IP));
+    TEST_ASSERT_EQUAL(4, queue.size());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_classify_by_pdu_and_varbinds);
+    RUN_TEST(test_walk_demotes_get_next);
+    RUN_TEST(test_queue_serves_highest_class_first);
+    RUN_TEST(test_queue_does_not_starve_low_class);
+    RUN_TEST(test_clients_share_processing_time);
+    RUN_TEST(test_one_client_cannot_fill_queue);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
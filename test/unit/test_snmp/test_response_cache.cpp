@@ -0,0 +1,259 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "ResponseCache.h"
+#include "ASN1Types.h"
+#include "MIB.h"
+#include "snmp_requests.h"
+
+using namespace ASN1;
+
+static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+static constexpr OID COUNTER_OID{"1.3.6.1.4.1.63050.8.1"};
+
+static int32_t counter;
+
+void setUp(void) {
+    counter = 1;
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void addCounter(MIB& mib) {
+    mib.registerNode(COUNTER_OID, MIB::NodeType::INTEGER, MIB::Access::READ_WRITE,
+        []() {
+            ASN1Object value(ASN1Object::Type::INTEGER);
+            value.setInteger(counter);
+            return value;
+        },
+        [](const ASN1Object& value) {
+            counter = value.getInteger();
+            return true;
+        });
+}
+
+static int32_t firstInteger(const SNMPMessage& message) {
+    int32_t value = -1;
+    if (message.getVarBindViewCount() > 0) {
+        message.getVarBindViews()[0].value.getInteger(value);
+    }
+    return value;
+}
+
+// Answers one GET as the agent does: from the cache, else the general path and store
+static uint16_t poll(ResponseCache& cache, MIB& mib, int32_t requestID, const OID* oids,
+                     size_t count, uint32_t now, uint8_t* buffer, const uint8_t*& response) {
+    uint8_t request[SNMPMessage::MAX_PACKET_SIZE];
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, requestID, oids, count,
+                                 request, sizeof(request));
+    ResponseCache::Key key;
+    if (!ResponseCache::makeKey(request, size, key)) {
+        return 0;
+    }
+    uint16_t responseSize = cache.lookup(key, mib.getGeneration(), now, buffer,
+                                         SNMPMessage::MAX_PACKET_SIZE, response);
+    if (responseSize > 0) {
+        return responseSize;
+    }
+    uint32_t volatileReads = mib.getVolatileReads();
+    responseSize = encodeResponse(request, size, mib, buffer, SNMPMessage::MAX_PACKET_SIZE);
+    response = buffer;
+    if (mib.getVolatileReads() == volatileReads) {
+        cache.store(key, mib.getGeneration(), now, response, responseSize);
+    }
+    return responseSize;
+}
+
+void test_hit_matches_general_path() {
+    MIB mib;
+    mib.initialize();
+    ResponseCache cache;
+    const OID oids[] = {SYS_DESCR_OID, SYS_NAME_OID};
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const uint8_t* response = nullptr;
+    TEST_ASSERT_TRUE(poll(cache, mib, 0x10, oids, 2, 0, buffer, response) > 0);
+    TEST_ASSERT_EQUAL(0, cache.getHits());
+    TEST_ASSERT_EQUAL(1, cache.getMisses());
+
+    // Request-ids of other lengths are patched into the cached body
+    const int32_t ids[] = {0x11, 0x123456, -1, 0x7FFFFFFF};
+    for (int32_t id : ids) {
+        uint8_t request[SNMPMessage::MAX_PACKET_SIZE];
+        uint8_t expected[SNMPMessage::MAX_PACKET_SIZE];
+        uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, id, oids, 2,
+                                     request, sizeof(request));
+        uint16_t expectedSize = encodeResponse(request, size, mib, expected, sizeof(expected));
+
+        uint16_t responseSize = poll(cache, mib, id, oids, 2, 10, buffer, response);
+        TEST_ASSERT_EQUAL(expectedSize, responseSize);
+        TEST_ASSERT_TRUE(response >= buffer && response + responseSize <= buffer + sizeof(buffer));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, response, responseSize);
+    }
+    TEST_ASSERT_EQUAL(4, cache.getHits());
+    TEST_ASSERT_EQUAL(1, cache.getMisses());
+}
+
+void test_entry_expires() {
+    MIB mib;
+    mib.initialize();
+    ResponseCache cache(100);
+    const OID oids[] = {SYS_DESCR_OID};
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const uint8_t* response = nullptr;
+    poll(cache, mib, 1, oids, 1, 1000, buffer, response);
+    poll(cache, mib, 2, oids, 1, 1099, buffer, response);
+    TEST_ASSERT_EQUAL(1, cache.getHits());
+
+    poll(cache, mib, 3, oids, 1, 1100, buffer, response);
+    TEST_ASSERT_EQUAL(1, cache.getHits());
+    TEST_ASSERT_EQUAL(2, cache.getMisses());
+}
+
+void test_mib_change_invalidates() {
+    MIB mib;
+    mib.initialize();
+    addCounter(mib);
+    ResponseCache cache;
+    const OID oids[] = {COUNTER_OID};
+
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const uint8_t* response = nullptr;
+    poll(cache, mib, 1, oids, 1, 0, buffer, response);
+
+    // A SET through the MIB moves the generation on
+    ASN1Object value;
+    value.setInteger(42);
+    TEST_ASSERT_TRUE(mib.setValue(COUNTER_OID, value));
+
+    SNMPMessage decoded;
+    uint16_t size = poll(cache, mib, 2, oids, 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(0, cache.getHits());
+    TEST_ASSERT_TRUE(decoded.decode(response, size));
+    TEST_ASSERT_EQUAL(42, firstInteger(decoded));
+
+    // So does a change the MIB is told about
+    counter = 43;
+    mib.markChanged();
+    size = poll(cache, mib, 3, oids, 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(0, cache.getHits());
+    TEST_ASSERT_TRUE(decoded.decode(response, size));
+    TEST_ASSERT_EQUAL(43, firstInteger(decoded));
+
+    poll(cache, mib, 4, oids, 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(1, cache.getHits());
+}
+
+void test_volatile_nodes_are_not_cached() {
+    MIB mib;
+    mib.initialize();
+    addCounter(mib);
+    TEST_ASSERT_TRUE(mib.setVolatile(COUNTER_OID));
+    TEST_ASSERT_FALSE(mib.setVolatile(SYS_DESCR_OID));     // A constant never changes
+    ResponseCache cache;
+
+    // Every poll reads the live value, with no markChanged() needed
+    const OID oids[] = {SYS_DESCR_OID, COUNTER_OID};
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const uint8_t* response = nullptr;
+    SNMPMessage decoded;
+    poll(cache, mib, 1, oids + 1, 1, 0, buffer, response);
+    counter = 2;
+    uint16_t size = poll(cache, mib, 2, oids + 1, 1, 10, buffer, response);
+    TEST_ASSERT_TRUE(decoded.decode(response, size));
+    TEST_ASSERT_EQUAL(2, firstInteger(decoded));
+
+    // Nor is a response with a volatile value among others
+    poll(cache, mib, 3, oids, 2, 20, buffer, response);
+    poll(cache, mib, 4, oids, 2, 30, buffer, response);
+    TEST_ASSERT_EQUAL(0, cache.getHits());
+
+    // The rest still is; sysUpTime is volatile from initialize()
+    static constexpr OID SYS_UPTIME_OID{"1.3.6.1.2.1.1.3"};
+    poll(cache, mib, 5, oids, 1, 40, buffer, response);
+    poll(cache, mib, 6, oids, 1, 50, buffer, response);
+    TEST_ASSERT_EQUAL(1, cache.getHits());
+    uint32_t volatileReads = mib.getVolatileReads();
+    ASN1Object upTime;
+    TEST_ASSERT_TRUE(mib.getValue(SYS_UPTIME_OID, upTime));
+    TEST_ASSERT_EQUAL(volatileReads + 1, mib.getVolatileReads());
+}
+
+void test_least_recently_used_is_replaced() {
+    MIB mib;
+    mib.initialize();
+    ResponseCache cache;
+
+    // One key per name; names outside the MIB get cached error responses
+    OID names[ResponseCache::CAPACITY + 1];
+    for (uint8_t i = 0; i <= ResponseCache::CAPACITY; i++) {
+        char text[32];
+        snprintf(text, sizeof(text), "1.3.6.1.4.1.63050.9.%u", i);
+        TEST_ASSERT_TRUE(OID::parse(text, names[i]));
+    }
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const uint8_t* response = nullptr;
+    for (uint8_t i = 0; i < ResponseCache::CAPACITY; i++) {
+        poll(cache, mib, i, &names[i], 1, 0, buffer, response);
+    }
+
+    // Touch the first, so the second is the oldest when the next arrives
+    poll(cache, mib, 100, &names[0], 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(1, cache.getHits());
+    poll(cache, mib, 101, &names[ResponseCache::CAPACITY], 1, 0, buffer, response);
+
+    poll(cache, mib, 102, &names[0], 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(2, cache.getHits());
+    // The second was replaced; storing it again replaces the third
+    poll(cache, mib, 103, &names[1], 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(2, cache.getHits());
+    poll(cache, mib, 104, &names[3], 1, 0, buffer, response);
+    TEST_ASSERT_EQUAL(3, cache.getHits());
+}
+
+void test_only_reads_are_cacheable() {
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    const OID oids[] = {SYS_NAME_OID};
+    ResponseCache::Key key;
+
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_NEXT_REQUEST, 1, oids, 1,
+                                 buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(ResponseCache::makeKey(buffer, size, key));
+    size = buildRequest(SNMPMessage::PDUType::SET_REQUEST, 1, oids, 1, buffer, sizeof(buffer));
+    TEST_ASSERT_FALSE(ResponseCache::makeKey(buffer, size, key));
+    TEST_ASSERT_FALSE(ResponseCache::makeKey(buffer, size - 1, key));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hit_matches_general_path);
+    RUN_TEST(test_entry_expires);
+    RUN_TEST(test_mib_change_invalidates);
+    RUN_TEST(test_volatile_nodes_are_not_cached);
+    RUN_TEST(test_least_recently_used_is_replaced);
+    RUN_TEST(test_only_reads_are_cacheable);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,192 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+#include "MIB.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static char largeText[1000];
+
+static ASN1Object getLargeValue() {
+    ASN1Object value(ASN1Object::Type::OCTET_STRING);
+    value.setStringRef(largeText, sizeof(largeText));
+    return value;
+}
+
+void test_value_encoded_size_matches_encode() {
+    static const uint32_t components[] = {1, 3, 6, 1, 4, 1, 63050, 1};
+    static const char text[200] = "long enough for a two-octet length";
+    ASN1Object values[6];
+    values[0].setInteger(-129);
+    values[1].setCounter64(0xFFFFFFFFFFFFFFFFull);
+    values[2].setTimeTicks(0x80000000);
+    values[3].setStringRef(text, sizeof(text));
+    values[4].setOIDRef(components, 8);
+
+    uint8_t buffer[256];
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL(values[i].encode(buffer, sizeof(buffer)), values[i].encodedSize());
+    }
+
+    // Invalid arcs cannot be encoded
+    static const uint32_t invalid[] = {3, 1};
+    values[0].setOIDRef(invalid, 2);
+    TEST_ASSERT_EQUAL(0, values[0].encodedSize());
+}
+
+static constexpr OID SYS_SERVICES_OID{"1.3.6.1.2.1.1.7.0"};
+static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1.0"};
+static constexpr OID COUNTER_OID{"1.3.6.1.4.1.63050.1.2"};
+static constexpr OID LARGE_OID{"1.3.6.1.4.1.63050.9"};
+
+void test_message_encoded_size_matches_encode() {
+    static const char text[300] = "pushes the varbind list past 255 bytes";
+    ASN1Object value;
+    SNMPMessage message;
+    message.setCommunity("public");
+    message.setPDUType(SNMPMessage::PDUType::GET_RESPONSE);
+    message.setRequestID(0x12345678);
+
+    // Empty varbind list
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    TEST_ASSERT_EQUAL(message.encode(buffer, sizeof(buffer)), message.encodedSize());
+
+    value.setInteger(42);
+    message.addVarBind(SYS_SERVICES_OID, value);
+    value.setStringRef(text, sizeof(text));
+    message.addVarBind(SYS_DESCR_OID, value);
+    value.setCounter32(0xFFFFFFFF);
+    message.addVarBind(COUNTER_OID, value);
+
+    uint16_t size = message.encodedSize();
+    TEST_ASSERT_TRUE(size > 300);
+    TEST_ASSERT_EQUAL(message.encode(buffer, sizeof(buffer)), size);
+
+    // A writer of exactly that size is filled from the first byte
+    BERWriter writer(buffer, size);
+    TEST_ASSERT_TRUE(message.encode(writer));
+    TEST_ASSERT_TRUE(writer.data() == buffer);
+}
+
+static void buildRequest(SNMPMessage& request, uint8_t* buffer, uint16_t maxSize, size_t varbinds) {
+    SNMPMessage message;
+    ASN1Object null;
+    message.setCommunity("public");
+    message.setRequestID(7);
+    for (size_t i = 0; i < varbinds; i++) {
+        message.addVarBind(LARGE_OID, null);
+    }
+    uint16_t length = message.encode(buffer, maxSize);
+    TEST_ASSERT_TRUE(request.decode(buffer, length));
+}
+
+void test_too_big_by_byte_budget() {
+    memset(largeText, 'x', sizeof(largeText));
+    MIB mib;
+    TEST_ASSERT_TRUE(mib.registerNode(LARGE_OID, MIB::NodeType::STRING,
+                                      MIB::Access::READ_ONLY, getLargeValue));
+
+    // One large value fits
+    uint8_t requestBuffer[128];
+    SNMPMessage request;
+    SNMPMessage response;
+    buildRequest(request, requestBuffer, sizeof(requestBuffer), 1);
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(1, response.getVarBindCount());
+    TEST_ASSERT_TRUE(response.encodedSize() <= SNMPMessage::MAX_PACKET_SIZE);
+
+    // Two do not, long before MAX_VARBINDS is reached
+    SNMPMessage tooBig;
+    buildRequest(request, requestBuffer, sizeof(requestBuffer), 2);
+    tooBig.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, tooBig.getErrorStatus());
+    TEST_ASSERT_EQUAL(0, tooBig.getErrorIndex());
+    TEST_ASSERT_EQUAL(0, tooBig.getVarBindCount());
+}
+
+void test_response_keeps_encoded_oids() {
+    static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+    static constexpr OID SYS_LOCATION_OID{"1.3.6.1.2.1.1.6"};
+    MIB mib;
+    mib.initialize();
+
+    uint8_t requestBuffer[64];
+    SNMPMessage message;
+    ASN1Object null;
+    message.setCommunity("public");
+    message.setPDUType(SNMPMessage::PDUType::GET_NEXT_REQUEST);
+    message.addVarBind(SYS_NAME_OID, null);
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(requestBuffer, message.encode(requestBuffer, sizeof(requestBuffer))));
+
+    // The next OID goes out as the MIB's bytes, never through text
+    SNMPMessage response;
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, response.getVarBindCount());
+    const SNMPMessage::VarBind& varbind = response.getVarBinds()[0];
+    TEST_ASSERT_EQUAL(SYS_LOCATION_OID.getEncodedLength(), varbind.oidLength);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(SYS_LOCATION_OID.getEncoded(), varbind.oid, varbind.oidLength);
+}
+
+void test_response_reused_from_pool() {
+    static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+    MIB mib;
+    mib.initialize();
+
+    uint8_t requestBuffer[64];
+    SNMPMessage message;
+    ASN1Object null;
+    message.setCommunity("public");
+    message.addVarBind(SYS_NAME_OID, null);
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(requestBuffer, message.encode(requestBuffer, sizeof(requestBuffer))));
+
+    // A pooled response starts from whatever the last request left
+    SNMPMessage response;
+    response.createResponse(request, mib);
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(1, response.getVarBindCount());
+
+    response.clear();
+    TEST_ASSERT_EQUAL(0, response.getVarBindCount());
+    TEST_ASSERT_EQUAL(0, response.getCommunityLength());
+    TEST_ASSERT_EQUAL(0, response.getRequestID());
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_value_encoded_size_matches_encode);
+    RUN_TEST(test_message_encoded_size_matches_encode);
+    RUN_TEST(test_too_big_by_byte_budget);
+    RUN_TEST(test_response_keeps_encoded_oids);
+    RUN_TEST(test_response_reused_from_pool);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
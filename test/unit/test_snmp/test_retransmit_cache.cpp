@@ -0,0 +1,178 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "RetransmitCache.h"
+#include "snmp_requests.h"
+
+static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+static constexpr uint32_t MANAGER_IP = 0x0A000001;
+static constexpr uint16_t MANAGER_PORT = 40000;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void storeResponse(RetransmitCache& cache, const RetransmitCache::Key& key,
+                          uint32_t now, uint8_t fill, uint16_t size) {
+    uint8_t response[RetransmitCache::MAX_RESPONSE_SIZE + 1];
+    memset(response, fill, sizeof(response));
+    cache.store(key, now, response, size);
+}
+
+void test_retransmission_answered_from_store() {
+    RetransmitCache cache;
+    uint8_t request[128];
+    uint16_t size = buildRequest(SNMPMessage::PDUType::SET_REQUEST, 77, &SYS_NAME_OID, 1,
+                                 request, sizeof(request));
+
+    RetransmitCache::Key key;
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT, key));
+    TEST_ASSERT_EQUAL(77, key.requestID);
+
+    uint16_t storedSize = 0;
+    TEST_ASSERT_NULL(cache.find(key, 0, storedSize));
+    storeResponse(cache, key, 0, 0xAB, 40);
+
+    // Same datagram from the same sender
+    RetransmitCache::Key again;
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT, again));
+    const uint8_t* stored = cache.find(again, 100, storedSize);
+    TEST_ASSERT_NOT_NULL(stored);
+    TEST_ASSERT_EQUAL(40, storedSize);
+    TEST_ASSERT_EQUAL_HEX8(0xAB, stored[39]);
+    TEST_ASSERT_EQUAL(1, cache.getDuplicates());
+}
+
+void test_other_requests_are_not_duplicates() {
+    RetransmitCache cache;
+    uint8_t request[128];
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, 5, &SYS_NAME_OID, 1,
+                                 request, sizeof(request));
+    RetransmitCache::Key key;
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT, key));
+    storeResponse(cache, key, 0, 0x01, 30);
+
+    uint16_t storedSize = 0;
+    RetransmitCache::Key other;
+
+    // Another port or address
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT + 1, other));
+    TEST_ASSERT_NULL(cache.find(other, 0, storedSize));
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP + 1, MANAGER_PORT, other));
+    TEST_ASSERT_NULL(cache.find(other, 0, storedSize));
+
+    // Another request-id, or another request with the same one
+    size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, 6, &SYS_NAME_OID, 1,
+                        request, sizeof(request));
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT, other));
+    TEST_ASSERT_NULL(cache.find(other, 0, storedSize));
+    size = buildRequest(SNMPMessage::PDUType::GET_NEXT_REQUEST, 5, &SYS_NAME_OID, 1,
+                        request, sizeof(request));
+    TEST_ASSERT_TRUE(RetransmitCache::makeKey(request, size, MANAGER_IP, MANAGER_PORT, other));
+    TEST_ASSERT_NULL(cache.find(other, 0, storedSize));
+
+    // Past the window, the same id is a new request
+    TEST_ASSERT_NULL(cache.find(key, RetransmitCache::DEFAULT_WINDOW_MS, storedSize));
+    TEST_ASSERT_EQUAL(0, cache.getDuplicates());
+
+    TEST_ASSERT_FALSE(RetransmitCache::makeKey(request, 3, MANAGER_IP, MANAGER_PORT, other));
+}
+
+void test_oldest_entry_overwritten() {
+    RetransmitCache cache;
+    RetransmitCache::Key keys[RetransmitCache::CAPACITY + 1];
+    for (uint8_t i = 0; i <= RetransmitCache::CAPACITY; i++) {
+        keys[i] = {MANAGER_IP, static_cast<uint16_t>(MANAGER_PORT + i), i, 0x1234u + i};
+        storeResponse(cache, keys[i], 0, i, 10);
+    }
+
+    uint16_t storedSize = 0;
+    TEST_ASSERT_NULL(cache.find(keys[0], 0, storedSize));
+    for (uint8_t i = 1; i <= RetransmitCache::CAPACITY; i++) {
+        const uint8_t* stored = cache.find(keys[i], 0, storedSize);
+        TEST_ASSERT_NOT_NULL(stored);
+        TEST_ASSERT_EQUAL_HEX8(i, stored[0]);
+    }
+
+    // Too large to keep
+    RetransmitCache::Key large = {MANAGER_IP + 1, MANAGER_PORT, 100, 0};
+    storeResponse(cache, large, 0, 0xFF, RetransmitCache::MAX_RESPONSE_SIZE + 1);
+    TEST_ASSERT_NULL(cache.find(large, 0, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(keys[1], 0, storedSize));
+}
+
+void test_one_client_keeps_few_entries() {
+    RetransmitCache cache;
+    RetransmitCache::Key quiet = {MANAGER_IP + 1, MANAGER_PORT, 1, 0x1111u};
+    storeResponse(cache, quiet, 0, 0x11, 10);
+
+    // A busy manager overwrites only its own oldest responses
+    RetransmitCache::Key busy[RetransmitCache::CAPACITY * 2];
+    for (uint8_t i = 0; i < RetransmitCache::CAPACITY * 2; i++) {
+        busy[i] = {MANAGER_IP, MANAGER_PORT, i, 0x2000u + i};
+        storeResponse(cache, busy[i], 10 + i, i, 10);
+    }
+
+    uint16_t storedSize = 0;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < RetransmitCache::CAPACITY * 2; i++) {
+        kept += cache.find(busy[i], 100, storedSize) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(RetransmitCache::MAX_PER_CLIENT, kept);
+    TEST_ASSERT_NOT_NULL(cache.find(busy[RetransmitCache::CAPACITY * 2 - 1], 100, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(quiet, 100, storedSize));
+
+    // The same address from another port is another client
+    RetransmitCache::Key otherPort = {MANAGER_IP, MANAGER_PORT + 1, 0, 0x3000u};
+    storeResponse(cache, otherPort, 30, 0x33, 10);
+    TEST_ASSERT_NOT_NULL(cache.find(otherPort, 100, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(busy[RetransmitCache::CAPACITY * 2 - 2], 100, storedSize));
+
+    // Fill the cache; once quiet's entry has expired it is taken first
+    RetransmitCache::Key others[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        others[i] = {MANAGER_IP + 10 + i, MANAGER_PORT, i, 0x5000u + i};
+        storeResponse(cache, others[i], 40, i, 10);
+    }
+    uint32_t later = RetransmitCache::DEFAULT_WINDOW_MS + 5;
+    RetransmitCache::Key late = {MANAGER_IP + 2, MANAGER_PORT, 9, 0x4000u};
+    storeResponse(cache, late, later, 0x44, 10);
+    TEST_ASSERT_NOT_NULL(cache.find(late, later, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(otherPort, later, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(busy[RetransmitCache::CAPACITY * 2 - 1], later, storedSize));
+    TEST_ASSERT_NOT_NULL(cache.find(busy[RetransmitCache::CAPACITY * 2 - 2], later, storedSize));
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_NOT_NULL(cache.find(others[i], later, storedSize));
+    }
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_retransmission_answered_from_store);
+    RUN_TEST(test_other_requests_are_not_duplicates);
+    RUN_TEST(test_oldest_entry_overwritten);
+    RUN_TEST(test_one_client_keeps_few_entries);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
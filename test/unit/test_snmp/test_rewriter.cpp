@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "SNMPRewriter.h"
+#include "ASN1Types.h"
+#include "MIB.h"
+#include "snmp_requests.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static constexpr OID SYS_DESCR_OID{"1.3.6.1.2.1.1.1"};
+static constexpr OID SYS_NAME_OID{"1.3.6.1.2.1.1.5"};
+static constexpr OID SYS_LOCATION_OID{"1.3.6.1.2.1.1.6"};
+static constexpr OID LARGE_OID{"1.3.6.1.4.1.63050.9"};
+static constexpr OID MISSING_OID{"1.3.6.1.4.1.63050.99"};
+
+static char largeText[1000];
+
+static ASN1Object getLargeValue() {
+    ASN1Object value(ASN1Object::Type::OCTET_STRING);
+    value.setStringRef(largeText, sizeof(largeText));
+    return value;
+}
+
+static void checkMatchesGeneralPath(SNMPMessage::PDUType type, const OID* oids, size_t count, MIB& mib) {
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    uint8_t expected[SNMPMessage::MAX_PACKET_SIZE];
+    uint16_t size = buildRequest(type, 0x1234, oids, count, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(size > 0);
+    uint16_t expectedSize = encodeResponse(buffer, size, mib, expected, sizeof(expected));
+    TEST_ASSERT_TRUE(expectedSize > 0);
+
+    const uint8_t* response = nullptr;
+    uint16_t responseSize = SNMPRewriter::rewrite(buffer, size, sizeof(buffer), mib, response);
+    TEST_ASSERT_EQUAL(expectedSize, responseSize);
+    TEST_ASSERT_TRUE(response >= buffer && response + responseSize <= buffer + sizeof(buffer));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, response, responseSize);
+}
+
+void test_rewrite_get_matches_general_path() {
+    MIB mib;
+    mib.initialize();
+
+    const OID oids[] = {SYS_DESCR_OID, SYS_NAME_OID, SYS_LOCATION_OID};
+    checkMatchesGeneralPath(SNMPMessage::PDUType::GET_REQUEST, oids, 1, mib);
+    checkMatchesGeneralPath(SNMPMessage::PDUType::GET_REQUEST, oids, 3, mib);
+}
+
+void test_rewrite_getnext_matches_general_path() {
+    MIB mib;
+    mib.initialize();
+
+    const OID oids[] = {SYS_DESCR_OID, SYS_NAME_OID, OID("1.3.6.1.2.1.1")};
+    checkMatchesGeneralPath(SNMPMessage::PDUType::GET_NEXT_REQUEST, oids, 3, mib);
+}
+
+void test_rewrite_grows_within_buffer() {
+    memset(largeText, 'x', sizeof(largeText));
+    MIB mib;
+    TEST_ASSERT_TRUE(mib.registerNode(LARGE_OID, MIB::NodeType::STRING,
+                                      MIB::Access::READ_ONLY, getLargeValue));
+
+    // A small request with a large value moves far past its own end
+    const OID oids[] = {LARGE_OID};
+    checkMatchesGeneralPath(SNMPMessage::PDUType::GET_REQUEST, oids, 1, mib);
+}
+
+static void checkDeclined(SNMPMessage::PDUType type, const OID* oids, size_t count,
+                          MIB& mib, uint16_t capacity) {
+    uint8_t buffer[SNMPMessage::MAX_PACKET_SIZE];
+    uint8_t original[SNMPMessage::MAX_PACKET_SIZE];
+    uint16_t size = buildRequest(type, 0x1234, oids, count, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(size > 0 && size <= capacity);
+    memcpy(original, buffer, size);
+
+    const uint8_t* response = nullptr;
+    TEST_ASSERT_EQUAL(0, SNMPRewriter::rewrite(buffer, size, capacity, mib, response));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(original, buffer, size);
+}
+
+void test_rewrite_leaves_other_requests_untouched() {
+    memset(largeText, 'x', sizeof(largeText));
+    MIB mib;
+    mib.initialize();
+    TEST_ASSERT_TRUE(mib.registerNode(LARGE_OID, MIB::NodeType::STRING,
+                                      MIB::Access::READ_ONLY, getLargeValue));
+
+    // Other PDU types
+    const OID name[] = {SYS_NAME_OID};
+    checkDeclined(SNMPMessage::PDUType::SET_REQUEST, name, 1, mib, SNMPMessage::MAX_PACKET_SIZE);
+
+    // noSuchName, in either position
+    const OID missing[] = {SYS_NAME_OID, MISSING_OID};
+    checkDeclined(SNMPMessage::PDUType::GET_REQUEST, missing, 2, mib, SNMPMessage::MAX_PACKET_SIZE);
+
+    // tooBig
+    const OID large[] = {LARGE_OID, LARGE_OID};
+    checkDeclined(SNMPMessage::PDUType::GET_REQUEST, large, 2, mib, SNMPMessage::MAX_PACKET_SIZE);
+
+    // Fits in a packet but not in this buffer
+    checkDeclined(SNMPMessage::PDUType::GET_REQUEST, large, 1, mib, 512);
+
+    // Truncated request
+    uint8_t buffer[64];
+    uint16_t size = buildRequest(SNMPMessage::PDUType::GET_REQUEST, 0x1234, name, 1,
+                                 buffer, sizeof(buffer));
+    const uint8_t* response = nullptr;
+    TEST_ASSERT_EQUAL(0, SNMPRewriter::rewrite(buffer, size - 1, sizeof(buffer), mib, response));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rewrite_get_matches_general_path);
+    RUN_TEST(test_rewrite_getnext_matches_general_path);
+    RUN_TEST(test_rewrite_grows_within_buffer);
+    RUN_TEST(test_rewrite_leaves_other_requests_untouched);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,352 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+#include "BERWriter.h"
+#include "MIB.h"
+
+using namespace ASN1;
+
+static constexpr OID LEVEL_OID{"1.3.6.1.4.1.63050.7.1"};
+static constexpr OID LABEL_OID{"1.3.6.1.4.1.63050.7.2"};
+static constexpr OID SERIAL_OID{"1.3.6.1.4.1.63050.7.3"};
+static constexpr OID BROKEN_OID{"1.3.6.1.4.1.63050.7.4"};
+static constexpr OID MISSING_OID{"1.3.6.1.4.1.63050.7.9"};
+static const char* const WRITE_COMMUNITY = "private";
+
+// Store behind the writable nodes, with a snapshot for undo
+struct Store {
+    int32_t level;
+    char label[16];
+};
+static Store store;
+static Store snapshot;
+static int begins;
+static int commits;
+static int aborts;
+
+void setUp(void) {
+    store.level = 1;
+    strcpy(store.label, "old");
+    begins = 0;
+    commits = 0;
+    aborts = 0;
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void buildMIB(MIB& mib, bool transaction) {
+    mib.registerNode(LEVEL_OID, MIB::NodeType::INTEGER, MIB::Access::READ_WRITE,
+        []() {
+            ASN1Object value(ASN1Object::Type::INTEGER);
+            value.setInteger(store.level);
+            return value;
+        },
+        [](const ASN1Object& value) {
+            store.level = value.getInteger();
+            return true;
+        },
+        [](const ASN1Object& value) {
+            return value.getInteger() >= 0 && value.getInteger() <= 10;
+        });
+    mib.registerNode(LABEL_OID, MIB::NodeType::STRING, MIB::Access::READ_WRITE,
+        []() {
+            ASN1Object value(ASN1Object::Type::OCTET_STRING);
+            value.setStringRef(store.label, strlen(store.label));
+            return value;
+        },
+        [](const ASN1Object& value) {
+            memcpy(store.label, value.getString(), value.getStringLength());
+            store.label[value.getStringLength()] = '\0';
+            return true;
+        },
+        [](const ASN1Object& value) {
+            return value.getStringLength() < sizeof(store.label);
+        });
+    mib.registerNode(SERIAL_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() {
+            ASN1Object value(ASN1Object::Type::INTEGER);
+            value.setInteger(1234);
+            return value;
+        });
+    mib.registerNode(BROKEN_OID, MIB::NodeType::INTEGER, MIB::Access::READ_WRITE,
+        []() {
+            return ASN1Object(ASN1Object::Type::INTEGER);
+        },
+        [](const ASN1Object&) {
+            return false;   // Storage failure at commit
+        });
+
+    if (transaction) {
+        mib.setTransaction({
+            []() { begins++; snapshot = store; },
+            []() { commits++; return true; },
+            []() { aborts++; store = snapshot; }
+        });
+    }
+}
+
+static void runSet(MIB& mib, uint8_t version, const OID* oids, const ASN1Object* values,
+                   size_t count, SNMPMessage& response, const char* community = WRITE_COMMUNITY) {
+    uint8_t buffer[256];
+    SNMPMessage message;
+    message.setVersion(version);
+    message.setCommunity(community);
+    message.setPDUType(SNMPMessage::PDUType::SET_REQUEST);
+    message.setRequestID(99);
+    for (size_t i = 0; i < count; i++) {
+        message.addVarBind(oids[i], values[i]);
+    }
+
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, message.encode(buffer, sizeof(buffer))));
+    response.createResponse(request, mib, WRITE_COMMUNITY);
+}
+
+// Error responses carry the request's varbinds as they were sent
+static void checkEchoed(const SNMPMessage& response, const OID* oids, const ASN1Object* values,
+                        size_t count) {
+    TEST_ASSERT_EQUAL(count, response.getVarBindCount());
+    for (size_t i = 0; i < count; i++) {
+        const SNMPMessage::VarBind& varBind = response.getVarBinds()[i];
+        TEST_ASSERT_EQUAL(oids[i].getEncodedLength(), varBind.oidLength);
+        TEST_ASSERT_EQUAL(0, memcmp(oids[i].getEncoded(), varBind.oid, varBind.oidLength));
+        TEST_ASSERT_EQUAL(values[i].getType(), varBind.value.getType());
+        if (values[i].getType() == ASN1Object::Type::OCTET_STRING) {
+            TEST_ASSERT_EQUAL(values[i].getStringLength(), varBind.value.getStringLength());
+            TEST_ASSERT_EQUAL(0, memcmp(values[i].getString(), varBind.value.getString(),
+                                        values[i].getStringLength()));
+        } else {
+            TEST_ASSERT_EQUAL(values[i].getInteger(), varBind.value.getInteger());
+        }
+    }
+}
+
+void test_set_commits_once() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    const OID oids[] = {LEVEL_OID, LABEL_OID};
+    ASN1Object values[2];
+    values[0].setInteger(7);
+    values[1].setType(ASN1Object::Type::OCTET_STRING);
+    values[1].setString("new label", 9);
+
+    SNMPMessage response;
+    runSet(mib, SNMPMessage::VERSION_2C, oids, values, 2, response);
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(7, store.level);
+    TEST_ASSERT_EQUAL_STRING("new label", store.label);
+
+    // Both setters ran inside one transaction
+    TEST_ASSERT_EQUAL(1, begins);
+    TEST_ASSERT_EQUAL(1, commits);
+    TEST_ASSERT_EQUAL(0, aborts);
+
+    // The response echoes the stored values
+    TEST_ASSERT_EQUAL(2, response.getVarBindCount());
+    TEST_ASSERT_EQUAL(7, response.getVarBinds()[0].value.getInteger());
+    TEST_ASSERT_EQUAL(9, response.getVarBinds()[1].value.getStringLength());
+}
+
+void test_set_checks_every_varbind_first() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    // The second varbind is refused, so the first is not applied either
+    const OID oids[] = {LEVEL_OID, LABEL_OID};
+    ASN1Object values[2];
+    values[0].setInteger(7);
+    values[1].setInteger(3);
+
+    SNMPMessage response;
+    runSet(mib, SNMPMessage::VERSION_2C, oids, values, 2, response);
+    TEST_ASSERT_EQUAL(7, response.getErrorStatus());     // wrongType
+    TEST_ASSERT_EQUAL(2, response.getErrorIndex());
+    checkEchoed(response, oids, values, 2);
+    TEST_ASSERT_EQUAL(1, store.level);
+    TEST_ASSERT_EQUAL(0, begins);
+
+    // Validator
+    values[1].setInteger(11);
+    runSet(mib, SNMPMessage::VERSION_2C, oids, values + 1, 1, response);
+    TEST_ASSERT_EQUAL(10, response.getErrorStatus());    // wrongValue
+    TEST_ASSERT_EQUAL(1, response.getErrorIndex());
+
+    // Access and unknown names
+    const OID readOnly[] = {SERIAL_OID};
+    runSet(mib, SNMPMessage::VERSION_2C, readOnly, values, 1, response);
+    TEST_ASSERT_EQUAL(17, response.getErrorStatus());    // notWritable
+    checkEchoed(response, readOnly, values, 1);
+    const OID missing[] = {MISSING_OID};
+    runSet(mib, SNMPMessage::VERSION_2C, missing, values, 1, response);
+    TEST_ASSERT_EQUAL(11, response.getErrorStatus());    // noCreation
+    TEST_ASSERT_EQUAL(0, begins);
+}
+
+void test_set_v1_error_codes() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    const OID oids[] = {LABEL_OID};
+    ASN1Object value;
+    value.setInteger(3);
+
+    SNMPMessage response;
+    runSet(mib, SNMPMessage::VERSION_1, oids, &value, 1, response);
+    TEST_ASSERT_EQUAL(3, response.getErrorStatus());     // badValue
+
+    const OID readOnly[] = {SERIAL_OID};
+    runSet(mib, SNMPMessage::VERSION_1, readOnly, &value, 1, response);
+    TEST_ASSERT_EQUAL(2, response.getErrorStatus());     // noSuchName
+}
+
+void test_set_undoes_on_setter_failure() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    const OID oids[] = {LEVEL_OID, BROKEN_OID};
+    ASN1Object values[2];
+    values[0].setInteger(7);
+    values[1].setInteger(1);
+
+    SNMPMessage response;
+    runSet(mib, SNMPMessage::VERSION_2C, oids, values, 2, response);
+    TEST_ASSERT_EQUAL(14, response.getErrorStatus());    // commitFailed
+    TEST_ASSERT_EQUAL(2, response.getErrorIndex());
+    TEST_ASSERT_EQUAL(1, aborts);
+    TEST_ASSERT_EQUAL(0, commits);
+    TEST_ASSERT_EQUAL(1, store.level);
+    checkEchoed(response, oids, values, 2);     // The values sent, not the stored ones
+
+    // Without a transaction the first write cannot be taken back
+    MIB plain;
+    buildMIB(plain, false);
+    runSet(plain, SNMPMessage::VERSION_2C, oids, values, 2, response);
+    TEST_ASSERT_EQUAL(15, response.getErrorStatus());    // undoFailed
+    TEST_ASSERT_EQUAL(7, store.level);
+}
+
+void test_set_error_echo_survives_encoding() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    // Longer than an inline value, so it would point into the request
+    const OID oids[] = {LABEL_OID, SERIAL_OID};
+    ASN1Object values[2];
+    values[0].setType(ASN1Object::Type::OCTET_STRING);
+    values[0].setStringRef("a label of 24 characters", 24);
+    values[1].setInteger(5);
+
+    uint8_t buffer[256];
+    SNMPMessage message;
+    message.setVersion(SNMPMessage::VERSION_2C);
+    message.setCommunity(WRITE_COMMUNITY);
+    message.setPDUType(SNMPMessage::PDUType::SET_REQUEST);
+    message.addVarBind(oids[0], values[0]);
+    message.addVarBind(oids[1], values[1]);
+    uint16_t size = message.encode(buffer, sizeof(buffer));
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, size));
+
+    // Encoded over the request, as the agent does
+    SNMPMessage response;
+    response.createResponse(request, mib, WRITE_COMMUNITY);
+    TEST_ASSERT_EQUAL(10, response.getErrorStatus());    // wrongValue: too long to store
+    uint16_t responseSize = response.encodedSize();
+    TEST_ASSERT_TRUE(responseSize > 0 && responseSize <= sizeof(buffer));
+    BERWriter writer(buffer, responseSize);
+    TEST_ASSERT_TRUE(response.encode(writer));
+
+    SNMPMessage decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, responseSize));
+    TEST_ASSERT_EQUAL(2, decoded.getVarBindViewCount());
+    ASN1Object label;
+    TEST_ASSERT_TRUE(label.decode(decoded.getVarBindViews()[0].value));
+    TEST_ASSERT_EQUAL(24, label.getStringLength());
+    TEST_ASSERT_EQUAL(0, memcmp("a label of 24 characters", label.getString(), 24));
+}
+
+void test_set_needs_write_community() {
+    MIB mib;
+    buildMIB(mib, true);
+
+    const OID oids[] = {LEVEL_OID};
+    ASN1Object value;
+    value.setInteger(7);
+
+    // The read community, or a prefix of the write one, changes nothing
+    SNMPMessage response;
+    runSet(mib, SNMPMessage::VERSION_2C, oids, &value, 1, response, "public");
+    TEST_ASSERT_EQUAL(16, response.getErrorStatus());    // authorizationError
+    TEST_ASSERT_EQUAL(0, response.getErrorIndex());
+    checkEchoed(response, oids, &value, 1);
+    runSet(mib, SNMPMessage::VERSION_2C, oids, &value, 1, response, "priv");
+    TEST_ASSERT_EQUAL(16, response.getErrorStatus());
+    runSet(mib, SNMPMessage::VERSION_1, oids, &value, 1, response, "public");
+    TEST_ASSERT_EQUAL(2, response.getErrorStatus());     // noSuchName
+    TEST_ASSERT_EQUAL(1, store.level);
+    TEST_ASSERT_EQUAL(0, begins);
+
+    // Without a write community the agent is read-only
+    uint8_t buffer[256];
+    SNMPMessage message;
+    message.setVersion(SNMPMessage::VERSION_2C);
+    message.setCommunity(WRITE_COMMUNITY);
+    message.setPDUType(SNMPMessage::PDUType::SET_REQUEST);
+    message.addVarBind(LEVEL_OID, value);
+    SNMPMessage request;
+    TEST_ASSERT_TRUE(request.decode(buffer, message.encode(buffer, sizeof(buffer))));
+    response.createResponse(request, mib);
+    TEST_ASSERT_EQUAL(16, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(1, store.level);
+
+    // An empty write community (the default) matches no community, not
+    // even an empty one
+    uint8_t emptyBuffer[256];
+    message.setCommunity("");
+    SNMPMessage emptyRequest;
+    TEST_ASSERT_TRUE(emptyRequest.decode(emptyBuffer, message.encode(emptyBuffer, sizeof(emptyBuffer))));
+    response.createResponse(emptyRequest, mib, "");
+    TEST_ASSERT_EQUAL(16, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(1, store.level);
+
+    // The community is read without decoding the message
+    const char* community = nullptr;
+    size_t length = 0;
+    TEST_ASSERT_TRUE(SNMPMessage::readCommunity(buffer, sizeof(buffer), community, length));
+    TEST_ASSERT_EQUAL(7, length);
+    TEST_ASSERT_EQUAL(0, memcmp(WRITE_COMMUNITY, community, length));
+    TEST_ASSERT_FALSE(SNMPMessage::readCommunity(buffer, 4, community, length));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_set_commits_once);
+    RUN_TEST(test_set_checks_every_varbind_first);
+    RUN_TEST(test_set_v1_error_codes);
+    RUN_TEST(test_set_undoes_on_setter_failure);
+    RUN_TEST(test_set_error_echo_survives_encoding);
+    RUN_TEST(test_set_needs_write_community);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,267 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "SNMPStreamDecoder.h"
+#include "BERStream.h"
+#include "ASN1Types.h"
+#include "ErrorHandler.h"
+
+using namespace ASN1;
+
+void setUp(void) {
+    // Setup code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+// GetRequest for sysDescr.0 and an enterprise OID with multi-byte arcs
+static const uint8_t GET_REQUEST[] = {
+    SEQUENCE_TAG, 0x36,
+    INTEGER_TAG, 0x01, 0x00,
+    OCTET_STRING_TAG, 0x06, 'p', 'u', 'b', 'l', 'i', 'c',
+    0xA0, 0x29,
+    INTEGER_TAG, 0x02, 0x12, 0x34,
+    INTEGER_TAG, 0x01, 0x00,
+    INTEGER_TAG, 0x01, 0x00,
+    SEQUENCE_TAG, 0x1D,
+    SEQUENCE_TAG, 0x0C,
+    OBJECT_IDENTIFIER_TAG, 0x08, 0x2B, 0x06, 0x01, 0x02, 0x01, 0x01, 0x01, 0x00,
+    NULL_TAG, 0x00,
+    SEQUENCE_TAG, 0x0D,
+    OBJECT_IDENTIFIER_TAG, 0x09, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x83, 0xEC, 0x4A, 0x01,
+    NULL_TAG, 0x00
+};
+
+static void assertDecodedRequest(const SNMPMessage& message) {
+    TEST_ASSERT_EQUAL(0, message.getVersion());
+    TEST_ASSERT_EQUAL(6, message.getCommunityLength());
+    TEST_ASSERT_EQUAL_STRING_LEN("public", message.getCommunity(), 6);
+    TEST_ASSERT_EQUAL_HEX8(0xA0, static_cast<uint8_t>(message.getPDUType()));
+    TEST_ASSERT_EQUAL_UINT32(0x1234, message.getRequestID());
+    TEST_ASSERT_EQUAL(2, message.getVarBindViewCount());
+
+    const SNMPMessage::VarBindView* views = message.getVarBindViews();
+    TEST_ASSERT_EQUAL(8, views[0].oid.length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(GET_REQUEST + 31, views[0].oid.data, 8);
+    TEST_ASSERT_EQUAL_HEX8(NULL_TAG, views[0].value.tag);
+    TEST_ASSERT_EQUAL(9, views[1].oid.length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(GET_REQUEST + 45, views[1].oid.data, 9);
+}
+
+void test_split_at_every_offset() {
+    // Simulate the RX ring wrapping at every possible point: the two
+    // halves live in separate, non-adjacent buffers.
+    for (uint16_t split = 0; split <= sizeof(GET_REQUEST); split++) {
+        uint8_t tail[sizeof(GET_REQUEST)];
+        uint8_t head[sizeof(GET_REQUEST)];
+        memcpy(tail, GET_REQUEST, split);
+        memcpy(head, GET_REQUEST + split, sizeof(GET_REQUEST) - split);
+
+        SNMPMessage message;
+        TEST_ASSERT_TRUE(message.decode(tail, split, head, sizeof(GET_REQUEST) - split));
+        assertDecodedRequest(message);
+    }
+}
+
+void test_contiguous_chunks_stay_zero_copy() {
+    // Byte-by-byte feeding of one buffer must not copy anything
+    SNMPMessage message;
+    SNMPStreamDecoder decoder(message);
+    decoder.begin();
+    for (uint16_t i = 0; i < sizeof(GET_REQUEST); i++) {
+        TEST_ASSERT_TRUE(decoder.feed(GET_REQUEST + i, 1));
+    }
+    TEST_ASSERT_TRUE(decoder.finish());
+    assertDecodedRequest(message);
+
+    const SNMPMessage::VarBindView* views = message.getVarBindViews();
+    TEST_ASSERT_TRUE(views[0].oid.data == GET_REQUEST + 31);
+    TEST_ASSERT_TRUE(views[1].oid.data == GET_REQUEST + 45);
+    TEST_ASSERT_TRUE(message.getCommunity() == reinterpret_cast<const char*>(GET_REQUEST + 7));
+}
+
+void test_truncated_and_malformed_input() {
+    SNMPMessage message;
+
+    // Every proper prefix is incomplete
+    for (uint16_t size = 2; size < sizeof(GET_REQUEST); size++) {
+        TEST_ASSERT_FALSE(message.decode(GET_REQUEST, size));
+    }
+
+    // Inner length running past its parent
+    uint8_t overlong[sizeof(GET_REQUEST)];
+    memcpy(overlong, GET_REQUEST, sizeof(overlong));
+    overlong[28] = 0x7F;
+    TEST_ASSERT_FALSE(message.decode(overlong, sizeof(overlong)));
+
+    // Indefinite length form is not valid in SNMP
+    memcpy(overlong, GET_REQUEST, sizeof(overlong));
+    overlong[1] = 0x80;
+    TEST_ASSERT_FALSE(message.decode(overlong, sizeof(overlong)));
+
+    // Varbind without a value
+    const uint8_t missingValue[] = {
+        SEQUENCE_TAG, 0x1C,
+        INTEGER_TAG, 0x01, 0x00,
+        OCTET_STRING_TAG, 0x01, 'p',
+        0xA0, 0x14,
+        INTEGER_TAG, 0x01, 0x01,
+        INTEGER_TAG, 0x01, 0x00,
+        INTEGER_TAG, 0x01, 0x00,
+        SEQUENCE_TAG, 0x09,
+        SEQUENCE_TAG, 0x07,
+        OBJECT_IDENTIFIER_TAG, 0x05, 0x2B, 0x06, 0x01, 0x02, 0x01
+    };
+    TEST_ASSERT_FALSE(message.decode(missingValue, sizeof(missingValue)));
+}
+
+static uint32_t lastErrorCode;
+
+static void recordError(const ErrorHandler::ErrorInfo& info) {
+    lastErrorCode = info.code;
+}
+
+// Reported code, or 0xFFFF if the message decoded
+static uint32_t decodeError(const uint8_t* buffer, uint16_t size) {
+    SNMPMessage message;
+    lastErrorCode = 0;
+    return message.decode(buffer, size) ? 0xFFFF : lastErrorCode;
+}
+
+void test_schema_error_codes() {
+    ErrorHandler::getInstance().registerCallback(recordError);
+    uint8_t buffer[sizeof(GET_REQUEST)];
+
+    // Not a SEQUENCE
+    memcpy(buffer, GET_REQUEST, sizeof(buffer));
+    buffer[0] = OCTET_STRING_TAG;
+    TEST_ASSERT_EQUAL_HEX32(0x4003, decodeError(buffer, sizeof(buffer)));
+
+    // Version with the wrong tag, and with a length past the message
+    memcpy(buffer, GET_REQUEST, sizeof(buffer));
+    buffer[2] = OCTET_STRING_TAG;
+    TEST_ASSERT_EQUAL_HEX32(0x4004, decodeError(buffer, sizeof(buffer)));
+    buffer[2] = INTEGER_TAG;
+    buffer[3] = 0x7F;
+    TEST_ASSERT_EQUAL_HEX32(0x4004, decodeError(buffer, sizeof(buffer)));
+
+    // Community with the wrong tag
+    memcpy(buffer, GET_REQUEST, sizeof(buffer));
+    buffer[5] = INTEGER_TAG;
+    TEST_ASSERT_EQUAL_HEX32(0x4005, decodeError(buffer, sizeof(buffer)));
+
+    // Bad request-id is dropped without a report
+    memcpy(buffer, GET_REQUEST, sizeof(buffer));
+    buffer[15] = OCTET_STRING_TAG;
+    TEST_ASSERT_EQUAL_HEX32(0, decodeError(buffer, sizeof(buffer)));
+
+    ErrorHandler::getInstance().removeCallback(recordError);
+}
+
+void test_trailing_fields_ignored() {
+    // Extra varbind field and an extra constructed PDU field
+    const uint8_t extended[] = {
+        SEQUENCE_TAG, 0x26,
+        INTEGER_TAG, 0x01, 0x00,
+        OCTET_STRING_TAG, 0x01, 'p',
+        0xA1, 0x1E,
+        INTEGER_TAG, 0x01, 0x05,
+        INTEGER_TAG, 0x01, 0x00,
+        INTEGER_TAG, 0x01, 0x00,
+        SEQUENCE_TAG, 0x0E,
+        SEQUENCE_TAG, 0x0C,
+        OBJECT_IDENTIFIER_TAG, 0x03, 0x2B, 0x06, 0x01,
+        NULL_TAG, 0x00,
+        SEQUENCE_TAG, 0x03, INTEGER_TAG, 0x01, 0x01,
+        SEQUENCE_TAG, 0x03, NULL_TAG, 0x01, 0x00
+    };
+
+    SNMPMessage message;
+    TEST_ASSERT_TRUE(message.decode(extended, sizeof(extended)));
+    TEST_ASSERT_EQUAL_HEX8(0xA1, static_cast<uint8_t>(message.getPDUType()));
+    TEST_ASSERT_EQUAL_UINT32(5, message.getRequestID());
+    TEST_ASSERT_EQUAL(1, message.getVarBindViewCount());
+    TEST_ASSERT_EQUAL(3, message.getVarBindViews()[0].oid.length);
+}
+
+static uint16_t primitiveCount;
+static uint16_t pieceBytes;
+static uint16_t carriedCount;
+
+static bool countConstructed(void*, uint8_t, uint16_t, uint8_t) {
+    return true;
+}
+
+static bool countPrimitive(void*, uint8_t, const uint8_t*, uint16_t length,
+                           uint8_t, bool carried, bool more) {
+    if (carried) {
+        carriedCount++;
+    }
+    pieceBytes += length;
+    if (!more) {
+        primitiveCount++;
+    }
+    return true;
+}
+
+static bool countEnd(void*, uint8_t, uint8_t) {
+    return true;
+}
+
+void test_long_content_arrives_in_pieces() {
+    // A value longer than the carry buffer, split three ways
+    uint8_t encoded[3 + 200];
+    encoded[0] = OCTET_STRING_TAG;
+    encoded[1] = 0x81;
+    encoded[2] = 200;
+    memset(encoded + 3, 'x', 200);
+
+    primitiveCount = 0;
+    pieceBytes = 0;
+    carriedCount = 0;
+    BERStreamParser parser({nullptr, countConstructed, countPrimitive, countEnd});
+
+    uint8_t first[50], second[100], third[53];
+    memcpy(first, encoded, sizeof(first));
+    memcpy(second, encoded + 50, sizeof(second));
+    memcpy(third, encoded + 150, sizeof(third));
+    TEST_ASSERT_TRUE(parser.feed(first, sizeof(first)));
+    TEST_ASSERT_TRUE(parser.feed(second, sizeof(second)));
+    TEST_ASSERT_FALSE(parser.isComplete());
+    TEST_ASSERT_TRUE(parser.feed(third, sizeof(third)));
+    TEST_ASSERT_TRUE(parser.isComplete());
+    TEST_ASSERT_EQUAL(1, primitiveCount);
+    TEST_ASSERT_EQUAL(200, pieceBytes);
+    TEST_ASSERT_EQUAL(0, carriedCount);
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_split_at_every_offset);
+    RUN_TEST(test_contiguous_chunks_stay_zero_copy);
+    RUN_TEST(test_truncated_and_malformed_input);
+    RUN_TEST(test_schema_error_codes);
+    RUN_TEST(test_trailing_fields_ignored);
+    RUN_TEST(test_long_content_arrives_in_pieces);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
@@ -0,0 +1,191 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "SNMPMessage.h"
+#include "TrapEmitter.h"
+#include "PowerMonitor.h"
+#include "ASN1Types.h"
+
+using namespace ASN1;
+
+static constexpr uint32_t MANAGER_IP = 0x0A000001;
+static constexpr OID SYS_UPTIME_OID{"1.3.6.1.2.1.1.3.0"};
+static constexpr OID SNMP_TRAP_OID{"1.3.6.1.6.3.1.1.4.1.0"};
+static constexpr OID POWER_LOST_OID{"1.3.6.1.4.1.63050.1.0.1"};
+
+// Datagrams handed to the network
+static uint8_t sentBytes[TrapEmitter::MAX_PDU_SIZE];
+static uint16_t sentSize;
+static uint32_t sentIP;
+static uint16_t sentPort;
+static int sends;
+
+static bool capture(const uint8_t* data, uint16_t size, uint32_t remoteIP, uint16_t remotePort) {
+    memcpy(sentBytes, data, size);
+    sentSize = size;
+    sentIP = remoteIP;
+    sentPort = remotePort;
+    sends++;
+    return true;
+}
+
+void setUp(void) {
+    sentSize = 0;
+    sends = 0;
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void checkName(const OID& expected, const BERView& name) {
+    TEST_ASSERT_EQUAL(expected.getEncodedLength(), name.length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected.getEncoded(), name.data, name.length);
+}
+
+static void raisePowerLost(TrapEmitter& traps) {
+    const uint32_t values[] = {0, 3};
+    TEST_ASSERT_TRUE(traps.raise(TrapEmitter::Event::POWER_LOST, 4200, values));
+}
+
+void test_trap_encoded_from_template() {
+    TrapEmitter traps;
+    TEST_ASSERT_TRUE(traps.setDestination(MANAGER_IP, TrapEmitter::TRAP_PORT, "public", false));
+    raisePowerLost(traps);
+    traps.process(0, capture);
+
+    TEST_ASSERT_EQUAL(1, sends);
+    TEST_ASSERT_EQUAL(MANAGER_IP, sentIP);
+    TEST_ASSERT_EQUAL(162, sentPort);
+
+    SNMPMessage trap;
+    TEST_ASSERT_TRUE(trap.decode(sentBytes, sentSize));
+    TEST_ASSERT_EQUAL(SNMPMessage::VERSION_2C, trap.getVersion());
+    TEST_ASSERT_EQUAL(0xA7, static_cast<uint8_t>(trap.getPDUType()));
+    TEST_ASSERT_EQUAL(0, memcmp(trap.getCommunity(), "public", 6));
+
+    // sysUpTime.0, snmpTrapOID.0, then the event's values
+    TEST_ASSERT_EQUAL(4, trap.getVarBindViewCount());
+    const SNMPMessage::VarBindView* varbinds = trap.getVarBindViews();
+    uint32_t ticks = 0;
+    checkName(SYS_UPTIME_OID, varbinds[0].oid);
+    TEST_ASSERT_EQUAL(TIMETICKS_TAG, varbinds[0].value.tag);
+    TEST_ASSERT_TRUE(varbinds[0].value.getUnsigned(ticks));
+    TEST_ASSERT_EQUAL(4200, ticks);
+    checkName(SNMP_TRAP_OID, varbinds[1].oid);
+    checkName(POWER_LOST_OID, varbinds[1].value);
+    checkName(PowerMonitor::POWER_STATE_OID, varbinds[2].oid);
+    TEST_ASSERT_EQUAL(INTEGER_TAG, varbinds[2].value.tag);
+    checkName(PowerMonitor::POWER_LOSS_COUNT_OID, varbinds[3].oid);
+    TEST_ASSERT_EQUAL(COUNTER_TAG, varbinds[3].value.tag);
+    TEST_ASSERT_EQUAL_HEX8(3, varbinds[3].value.data[0]);
+
+    // A trap is sent once
+    traps.process(10000, capture);
+    TEST_ASSERT_EQUAL(1, sends);
+    TEST_ASSERT_EQUAL(0, traps.getPending());
+}
+
+void test_no_destination_sends_nothing() {
+    TrapEmitter traps;
+    raisePowerLost(traps);
+    traps.process(0, capture);
+    TEST_ASSERT_EQUAL(0, sends);
+    TEST_ASSERT_EQUAL(0, traps.getPending());
+
+    // The ring was drained
+    for (uint8_t i = 0; i + 1 < TrapEmitter::EVENT_RING_SIZE; i++) {
+        raisePowerLost(traps);
+    }
+    const uint32_t values[] = {0, 0};
+    TEST_ASSERT_FALSE(traps.raise(TrapEmitter::Event::POWER_LOST, 0, values));
+    TEST_ASSERT_EQUAL(1, traps.getDropped());
+}
+
+void test_inform_retried_with_backoff() {
+    TrapEmitter traps;
+    TEST_ASSERT_TRUE(traps.setDestination(MANAGER_IP, TrapEmitter::TRAP_PORT, "public", true));
+    raisePowerLost(traps);
+
+    traps.process(0, capture);
+    TEST_ASSERT_EQUAL(1, sends);
+
+    // Due after 1 s, then 2 s, then 4 s
+    traps.process(999, capture);
+    TEST_ASSERT_EQUAL(1, sends);
+    traps.process(1000, capture);
+    TEST_ASSERT_EQUAL(2, sends);
+    traps.process(2999, capture);
+    TEST_ASSERT_EQUAL(2, sends);
+    traps.process(3000, capture);
+    TEST_ASSERT_EQUAL(3, sends);
+    traps.process(7000, capture);
+    TEST_ASSERT_EQUAL(4, sends);
+
+    // Given up after the last retry times out
+    TEST_ASSERT_EQUAL(1, traps.getPending());
+    traps.process(15000, capture);
+    TEST_ASSERT_EQUAL(4, sends);
+    TEST_ASSERT_EQUAL(0, traps.getPending());
+    TEST_ASSERT_EQUAL(1, traps.getFailed());
+}
+
+void test_inform_acknowledged() {
+    TrapEmitter traps;
+    TEST_ASSERT_TRUE(traps.setDestination(MANAGER_IP, TrapEmitter::TRAP_PORT, "public", true));
+    raisePowerLost(traps);
+    traps.process(0, capture);
+
+    SNMPMessage inform;
+    TEST_ASSERT_TRUE(inform.decode(sentBytes, sentSize));
+    TEST_ASSERT_EQUAL(0xA6, static_cast<uint8_t>(inform.getPDUType()));
+
+    uint8_t packet[128];
+    SNMPMessage response;
+    response.setVersion(SNMPMessage::VERSION_2C);
+    response.setCommunity("public");
+    response.setPDUType(SNMPMessage::PDUType::GET_RESPONSE);
+    response.setRequestID(inform.getRequestID());
+    uint16_t size = response.encode(packet, sizeof(packet));
+
+    // Consumed, but only the destination can acknowledge
+    TEST_ASSERT_TRUE(traps.handleResponse(packet, size, MANAGER_IP + 1));
+    TEST_ASSERT_EQUAL(1, traps.getPending());
+    TEST_ASSERT_TRUE(traps.handleResponse(packet, size, MANAGER_IP));
+    TEST_ASSERT_EQUAL(0, traps.getPending());
+    TEST_ASSERT_EQUAL(1, traps.getAcknowledged());
+
+    traps.process(1000, capture);
+    TEST_ASSERT_EQUAL(1, sends);
+
+    // Requests are left to the agent
+    response.setPDUType(SNMPMessage::PDUType::GET_REQUEST);
+    size = response.encode(packet, sizeof(packet));
+    TEST_ASSERT_FALSE(traps.handleResponse(packet, size, MANAGER_IP));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_trap_encoded_from_template);
+    RUN_TEST(test_no_destination_sends_nothing);
+    RUN_TEST(test_inform_retried_with_backoff);
+    RUN_TEST(test_inform_acknowledged);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
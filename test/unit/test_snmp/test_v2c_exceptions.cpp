@@ -0,0 +1,188 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "SNMPMessage.h"
+#include "ASN1Types.h"
+#include "BERView.h"
+#include "BERWriter.h"
+#include "MIB.h"
+
+using namespace ASN1;
+
+static constexpr OID SCALAR_OID{"1.3.6.1.4.1.63050.8.1.0"};
+static constexpr OID COLUMN_OID{"1.3.6.1.4.1.63050.8.2.1"};
+static constexpr OID LAST_OID{"1.3.6.1.4.1.63050.8.3"};
+
+static constexpr OID SCALAR_OBJECT{"1.3.6.1.4.1.63050.8.1"};
+static constexpr OID SCALAR_INSTANCE{"1.3.6.1.4.1.63050.8.1.7"};
+static constexpr OID COLUMN_ROW{"1.3.6.1.4.1.63050.8.2.1.4"};
+static constexpr OID MISSING_OID{"1.3.6.1.4.1.63050.8.9"};
+
+void setUp(void) {
+    // Set up code if needed before each test
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static ASN1Object integer(int32_t number) {
+    ASN1Object value(ASN1Object::Type::INTEGER);
+    value.setInteger(number);
+    return value;
+}
+
+static void buildMIB(MIB& mib) {
+    mib.registerNode(SCALAR_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(1); });
+    mib.registerNode(COLUMN_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(2); });
+    mib.registerNode(LAST_OID, MIB::NodeType::INTEGER, MIB::Access::READ_ONLY,
+        []() { return integer(3); });
+}
+
+// Request through createResponse and back through the decoder
+static bool roundTrip(MIB& mib, uint8_t version, SNMPMessage::PDUType type,
+                      const OID* oids, size_t count, SNMPMessage& decoded, uint8_t* buffer) {
+    uint8_t requestBuffer[256];
+    SNMPMessage message;
+    message.setVersion(version);
+    message.setCommunity("public");
+    message.setPDUType(type);
+    message.setRequestID(21);
+    for (size_t i = 0; i < count; i++) {
+        message.addVarBind(oids[i], ASN1Object(ASN1Object::Type::NULL_TYPE));
+    }
+
+    SNMPMessage request;
+    if (!request.decode(requestBuffer, message.encode(requestBuffer, sizeof(requestBuffer)))) {
+        return false;
+    }
+    SNMPMessage response;
+    response.createResponse(request, mib);
+    size_t size = response.encode(buffer, 256);
+    return size > 0 && decoded.decode(buffer, size);
+}
+
+void test_exception_type_for_name() {
+    MIB mib;
+    buildMIB(mib);
+
+    TEST_ASSERT_EQUAL(ASN1Object::Type::NO_SUCH_OBJECT,
+                      mib.getException(MISSING_OID.getEncoded(), MISSING_OID.getEncodedLength()));
+
+    // Object registered, instance not
+    TEST_ASSERT_EQUAL(ASN1Object::Type::NO_SUCH_INSTANCE,
+                      mib.getException(SCALAR_OBJECT.getEncoded(), SCALAR_OBJECT.getEncodedLength()));
+    TEST_ASSERT_EQUAL(ASN1Object::Type::NO_SUCH_INSTANCE,
+                      mib.getException(SCALAR_INSTANCE.getEncoded(), SCALAR_INSTANCE.getEncodedLength()));
+    TEST_ASSERT_EQUAL(ASN1Object::Type::NO_SUCH_INSTANCE,
+                      mib.getException(COLUMN_ROW.getEncoded(), COLUMN_ROW.getEncodedLength()));
+}
+
+void test_v2c_get_answers_every_varbind() {
+    MIB mib;
+    buildMIB(mib);
+
+    const OID oids[] = {SCALAR_OID, MISSING_OID, SCALAR_INSTANCE};
+    uint8_t buffer[256];
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(roundTrip(mib, SNMPMessage::VERSION_2C, SNMPMessage::PDUType::GET_REQUEST,
+                               oids, 3, response, buffer));
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(0, response.getErrorIndex());
+    TEST_ASSERT_EQUAL(3, response.getVarBindViewCount());
+
+    const SNMPMessage::VarBindView* views = response.getVarBindViews();
+    int32_t value = 0;
+    TEST_ASSERT_TRUE(views[0].value.getInteger(value));
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_EQUAL(NO_SUCH_OBJECT_TAG, views[1].value.tag);
+    TEST_ASSERT_EQUAL(0, views[1].value.length);
+    TEST_ASSERT_EQUAL(NO_SUCH_INSTANCE_TAG, views[2].value.tag);
+
+    // Names are echoed as requested
+    TEST_ASSERT_EQUAL(MISSING_OID.getEncodedLength(), views[1].oid.length);
+    TEST_ASSERT_EQUAL_MEMORY(MISSING_OID.getEncoded(), views[1].oid.data, views[1].oid.length);
+}
+
+void test_v1_get_keeps_no_such_name() {
+    MIB mib;
+    buildMIB(mib);
+
+    const OID oids[] = {SCALAR_OID, MISSING_OID};
+    uint8_t buffer[256];
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(roundTrip(mib, SNMPMessage::VERSION_1, SNMPMessage::PDUType::GET_REQUEST,
+                               oids, 2, response, buffer));
+    TEST_ASSERT_EQUAL(2, response.getErrorStatus());     // noSuchName
+    TEST_ASSERT_EQUAL(2, response.getErrorIndex());
+}
+
+void test_get_next_past_the_end() {
+    MIB mib;
+    buildMIB(mib);
+
+    const OID oids[] = {SCALAR_OID, LAST_OID};
+    uint8_t buffer[256];
+    SNMPMessage response;
+    TEST_ASSERT_TRUE(roundTrip(mib, SNMPMessage::VERSION_2C, SNMPMessage::PDUType::GET_NEXT_REQUEST,
+                               oids, 2, response, buffer));
+    TEST_ASSERT_EQUAL(0, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(2, response.getVarBindViewCount());
+
+    const SNMPMessage::VarBindView* views = response.getVarBindViews();
+    TEST_ASSERT_EQUAL_MEMORY(COLUMN_OID.getEncoded(), views[0].oid.data, views[0].oid.length);
+    TEST_ASSERT_EQUAL(END_OF_MIB_VIEW_TAG, views[1].value.tag);
+    TEST_ASSERT_EQUAL_MEMORY(LAST_OID.getEncoded(), views[1].oid.data, views[1].oid.length);
+
+    // SNMPv1 has no endOfMibView
+    TEST_ASSERT_TRUE(roundTrip(mib, SNMPMessage::VERSION_1, SNMPMessage::PDUType::GET_NEXT_REQUEST,
+                               oids, 2, response, buffer));
+    TEST_ASSERT_EQUAL(2, response.getErrorStatus());
+    TEST_ASSERT_EQUAL(2, response.getErrorIndex());
+}
+
+void test_exception_value_encoding() {
+    uint8_t buffer[8];
+    BERWriter writer(buffer, sizeof(buffer));
+    ASN1Object value(ASN1Object::Type::NO_SUCH_INSTANCE);
+    TEST_ASSERT_TRUE(value.encode(writer));
+    TEST_ASSERT_EQUAL(2, writer.size());
+    TEST_ASSERT_EQUAL_HEX8(0x81, writer.data()[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, writer.data()[1]);
+
+    BERReader reader(writer.data(), writer.size());
+    BERView view;
+    TEST_ASSERT_TRUE(reader.read(view));
+    ASN1Object decoded;
+    TEST_ASSERT_TRUE(decoded.decode(view));
+    TEST_ASSERT_EQUAL(ASN1Object::Type::NO_SUCH_INSTANCE, decoded.getType());
+    TEST_ASSERT_TRUE(ASN1Object::isException(decoded.getType()));
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_exception_type_for_name);
+    RUN_TEST(test_v2c_get_answers_every_varbind);
+    RUN_TEST(test_v1_get_keeps_no_such_name);
+    RUN_TEST(test_get_next_past_the_end);
+    RUN_TEST(test_exception_value_encoding);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}
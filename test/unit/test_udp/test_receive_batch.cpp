@@ -0,0 +1,185 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include "UDPStack.h"
+#include "W5500.h"
+
+// W5500 receive queue: datagrams back to back, as in the socket RX
+// buffer. An unread rest is parsed as the next datagram, as the chip
+// would read a header from the middle of the data.
+class MockW5500 : public W5500 {
+public:
+    static constexpr size_t MAX_DATAGRAMS = 16;
+    static constexpr size_t MAX_SIZE = 128;
+
+    MockW5500() : W5500(0, 0, 0), count_(0), next_(0), open_(false), offset_(0), shortRead_(0) {}
+
+    void queue(const uint8_t* data, uint16_t size, uint32_t ip, uint16_t port) {
+        Datagram& datagram = datagrams_[count_++];
+        memcpy(datagram.data, data, size);
+        datagram.size = size;
+        datagram.ip = ip;
+        datagram.port = port;
+    }
+
+    // The next read() returns at most this many bytes
+    void shortenNextRead(size_t size) { shortRead_ = size; }
+
+    size_t queued() const { return count_ - next_ + (open_ && offset_ < current().size ? 1 : 0); }
+
+    int parsePacket() override {
+        if (open_ && offset_ < current().size) {
+            // Unread rest: garbage header, from nowhere
+            _remote_ip = 0;
+            _remote_port = 0;
+            return current().size - offset_;
+        }
+        open_ = false;
+        if (next_ == count_) {
+            return 0;
+        }
+        next_++;
+        open_ = true;
+        offset_ = 0;
+        _remote_ip = current().ip;
+        _remote_port = current().port;
+        return current().size;
+    }
+
+    int read(uint8_t* buffer, size_t size) override {
+        if (!open_) {
+            return 0;
+        }
+        size_t left = current().size - offset_;
+        size_t chunk = size < left ? size : left;
+        if (shortRead_ > 0 && chunk > shortRead_) {
+            chunk = shortRead_;
+        }
+        shortRead_ = 0;
+        memcpy(buffer, current().data + offset_, chunk);
+        offset_ += chunk;
+        return static_cast<int>(chunk);
+    }
+
+private:
+    struct Datagram {
+        uint8_t data[MAX_SIZE];
+        uint16_t size;
+        uint32_t ip;
+        uint16_t port;
+    };
+
+    Datagram datagrams_[MAX_DATAGRAMS];
+    size_t count_;
+    size_t next_;           // Datagrams opened so far
+    bool open_;
+    size_t offset_;         // Read position in the open datagram
+    size_t shortRead_;
+
+    const Datagram& current() const { return datagrams_[next_ - 1]; }
+};
+
+static constexpr uint32_t MANAGER_IP = 0x0A000001;
+static constexpr uint16_t MANAGER_PORT = 40000;
+
+static uint8_t buffers[4][64];
+static UDPStack::Datagram datagrams[4];
+
+void setUp(void) {
+    for (uint8_t i = 0; i < 4; i++) {
+        datagrams[i] = {buffers[i], sizeof(buffers[i]), 0, 0, 0};
+    }
+}
+
+void tearDown(void) {
+    // Cleanup code if needed after each test
+}
+
+static void queueFilled(MockW5500& eth, uint8_t fill, uint16_t size, uint16_t port) {
+    uint8_t data[MockW5500::MAX_SIZE];
+    memset(data, fill, size);
+    eth.queue(data, size, MANAGER_IP, port);
+}
+
+void test_whole_datagrams_are_received() {
+    MockW5500 eth;
+    UDPStack udp(eth);
+    queueFilled(eth, 0x11, 40, MANAGER_PORT);
+    queueFilled(eth, 0x22, 64, MANAGER_PORT + 1);
+
+    TEST_ASSERT_EQUAL(2, udp.receiveBatch(datagrams, 4));
+    TEST_ASSERT_EQUAL(40, datagrams[0].size);
+    TEST_ASSERT_EQUAL_HEX8(0x11, buffers[0][39]);
+    TEST_ASSERT_EQUAL(MANAGER_IP, datagrams[0].remoteIP);
+    TEST_ASSERT_EQUAL(64, datagrams[1].size);
+    TEST_ASSERT_EQUAL(MANAGER_PORT + 1, datagrams[1].remotePort);
+    TEST_ASSERT_EQUAL(0, udp.receiveBatch(datagrams, 4));
+}
+
+void test_short_read_drops_the_datagram() {
+    MockW5500 eth;
+    UDPStack udp(eth);
+    queueFilled(eth, 0x11, 50, MANAGER_PORT);
+    queueFilled(eth, 0x22, 30, MANAGER_PORT + 1);
+
+    // The first comes back short: neither it nor its rest is handed on
+    eth.shortenNextRead(20);
+    TEST_ASSERT_EQUAL(1, udp.receiveBatch(datagrams, 4));
+    TEST_ASSERT_EQUAL(30, datagrams[0].size);
+    TEST_ASSERT_EQUAL_HEX8(0x22, buffers[0][0]);
+    TEST_ASSERT_EQUAL(MANAGER_PORT + 1, datagrams[0].remotePort);
+    TEST_ASSERT_EQUAL(0, eth.queued());
+}
+
+void test_oversize_datagram_is_read_out() {
+    MockW5500 eth;
+    UDPStack udp(eth);
+    queueFilled(eth, 0x33, 100, MANAGER_PORT);
+    queueFilled(eth, 0x44, 10, MANAGER_PORT);
+
+    TEST_ASSERT_EQUAL(1, udp.receiveBatch(datagrams, 4));
+    TEST_ASSERT_EQUAL(10, datagrams[0].size);
+    TEST_ASSERT_EQUAL_HEX8(0x44, buffers[0][0]);
+    TEST_ASSERT_EQUAL(0, eth.queued());
+}
+
+void test_drops_are_bounded_per_call() {
+    MockW5500 eth;
+    UDPStack udp(eth);
+    for (uint8_t i = 0; i < 6; i++) {
+        queueFilled(eth, i, 100, MANAGER_PORT);
+    }
+    queueFilled(eth, 0x55, 10, MANAGER_PORT);
+
+    // Two calls' worth of drops, then the good one
+    TEST_ASSERT_EQUAL(0, udp.receiveBatch(datagrams, 4));
+    TEST_ASSERT_EQUAL(3, eth.queued());
+    TEST_ASSERT_EQUAL(1, udp.receiveBatch(datagrams, 4));
+    TEST_ASSERT_EQUAL_HEX8(0x55, buffers[0][0]);
+}
+
+void setup() {
+    // Initialize LED pin
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Wait for board to settle and serial to be ready
+    delay(2000);
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+    UNITY_BEGIN();
+
+    RUN_TEST(test_whole_datagrams_are_received);
+    RUN_TEST(test_short_read_drops_the_datagram);
+    RUN_TEST(test_oversize_datagram_is_read_out);
+    RUN_TEST(test_drops_are_bounded_per_call);
+
+    UNITY_END();
+}
+
+void loop() {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+    delay(100);
+}